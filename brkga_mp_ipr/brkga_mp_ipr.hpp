@@ -49,27 +49,39 @@
 
 #include "fitness_type.hpp"
 #include "chromosome.hpp"
+#include "argsort.hpp"
 
 #include <algorithm>
+#include <any>
+#include <array>
+#include <bit>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <concepts>
+#include <condition_variable>
 #include <cstdint>
-#include <deque>
+#include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <omp.h>
 #include <random>
-#include <set>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <stdexcept>
 #include <sys/time.h>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -431,7 +443,11 @@ enum class Type {
 
 /// Specifies which individuals used to build the path.
 enum class Selection {
-    /// Selects, in the order, the best solution of each population.
+    /**
+     * \brief Selects, in the order, the best solution of each population.
+     * If they are too close, pairs of elite solutions are tried by
+     * increasing sum of their ranks.
+     */
     BESTSOLUTION,
 
     /// Chooses uniformly random solutions from the elite sets.
@@ -446,10 +462,28 @@ enum class DistanceFunctionType {
     /// Uses the default KendallTau distance calculator.
     KENDALLTAU,
 
+    /// Counts the pairs of positions whose keys are in different order,
+    /// estimated from a sample of pairs (see SampledKendallTauDistance).
+    /// It is a different metric from KENDALLTAU, not an estimate of it.
+    SAMPLED_KENDALLTAU,
+
     /// Indicates a custom function supplied by the user.
     CUSTOM
 };
 
+/// Specifies the candidate moves decoded in each step of the path.
+enum class Neighborhood {
+    /// Decodes all moves.
+    FULL,
+
+    /// Decodes a random sample of the square root of the number of moves.
+    SQUARE_ROOT,
+
+    /// Decodes a random sample of a fixed number of moves
+    /// (see BrkgaParams::pr_neighborhood_size).
+    FIXED
+};
+
 /// Specifies the result type/status of path relink procedure.
 enum class PathRelinkingResult {
     /**
@@ -565,11 +599,24 @@ EnumIO<BRKGA::PathRelinking::DistanceFunctionType>::enum_names() {
     static std::vector<std::string> enum_names_ {
         "HAMMING",
         "KENDALLTAU",
+        "SAMPLED_KENDALLTAU",
         "CUSTOM"
     };
     return enum_names_;
 }
 
+/// Template specialization to BRKGA::PathRelinking::Neighborhood.
+template <>
+INLINE const std::vector<std::string>&
+EnumIO<BRKGA::PathRelinking::Neighborhood>::enum_names() {
+    static std::vector<std::string> enum_names_ {
+        "FULL",
+        "SQUARE_ROOT",
+        "FIXED"
+    };
+    return enum_names_;
+}
+
 /// Template specialization to BRKGA::BiasFunctionType.
 template <>
 INLINE const std::vector<std::string>&
@@ -633,6 +680,24 @@ public:
     virtual double distance(const Chromosome& v1,
                             const Chromosome& v2) = 0;
 
+    /**
+     * \brief Returns true if the distance between two vectors is at least
+     * `min_distance`.
+     *
+     * The path relinking only needs to know whether the distance reaches a
+     * threshold, so implementations may stop scanning the vectors as soon as
+     * the answer is known. This default implementation computes the whole
+     * distance.
+     *
+     * \param v1 first chromosome.
+     * \param v2 second chromosome.
+     * \param min_distance the threshold.
+     */
+    virtual bool atLeast(const Chromosome& v1, const Chromosome& v2,
+                         const double min_distance) {
+        return distance(v1, v2) >= min_distance;
+    }
+
     /**
      * \brief Returns true if the changing of `key1` by `key2` affects
      *        the solution.
@@ -686,15 +751,47 @@ public:
             throw std::runtime_error("The size of the vector must "
                                      "be the same!");
 
-        unsigned dist = 0;
-        for(std::size_t i = 0; i < vector1.size(); ++i) {
-            if((vector1[i] < threshold) != (vector2[i] < threshold))
-                ++dist;
-        }
+        // Branch-free, so that the compiler can vectorize it.
+        std::size_t dist = 0;
+        for(std::size_t i = 0; i < vector1.size(); ++i)
+            dist += (vector1[i] < threshold) != (vector2[i] < threshold);
 
         return double(dist);
     }
 
+    /**
+     * \brief Returns true if the Hamming distance between two vectors is
+     * at least `min_distance`.
+     *
+     * The keys are scanned in chunks, stopping as soon as the distance is
+     * reached, or cannot be reached anymore.
+     *
+     * \param vector1 first vector
+     * \param vector2 second vector
+     * \param min_distance the threshold.
+     */
+    virtual bool atLeast(const Chromosome& vector1, const Chromosome& vector2,
+                         const double min_distance) override {
+        if(vector1.size() != vector2.size())
+            throw std::runtime_error("The size of the vector must "
+                                     "be the same!");
+
+        constexpr std::size_t CHUNK_SIZE = 64;
+        const std::size_t size = vector1.size();
+
+        std::size_t dist = 0;
+        for(std::size_t first = 0; ; first += CHUNK_SIZE) {
+            if(double(dist) >= min_distance)
+                return true;
+            if(first >= size || double(dist + size - first) < min_distance)
+                return false;
+
+            const std::size_t last = std::min(first + CHUNK_SIZE, size);
+            for(std::size_t i = first; i < last; ++i)
+                dist += (vector1[i] < threshold) != (vector2[i] < threshold);
+        }
+    }
+
     /**
      * \brief Returns true if the changing of `key1` by `key2` affects
      *        the solution.
@@ -724,6 +821,101 @@ public:
         return false;
     }
 
+    /** \name Threshold signatures
+     *
+     * A signature packs the binarized keys of a chromosome, 64 per word:
+     * bit `i` is set if key `i` is not below the threshold. The Hamming
+     * distance between two chromosomes is the number of different bits of
+     * their signatures, computed by XOR and popcount over `n / 64` words.
+     */
+    ///@{
+    /// Returns the number of words of the signature of `size` keys.
+    static std::size_t signatureSize(const std::size_t size) {
+        return (size + 63) / 64;
+    }
+
+    /**
+     * \brief Computes the signature of `vector`.
+     * \param vector the keys.
+     * \param[out] bits array with at least `signatureSize(vector.size())`
+     *        words.
+     */
+    void signature(const Chromosome& vector, std::uint64_t* bits) const {
+        const std::size_t size = vector.size();
+        for(std::size_t w = 0; w < signatureSize(size); ++w) {
+            const std::size_t first = w * 64;
+            const std::size_t last = std::min(first + 64, size);
+            std::uint64_t word = 0;
+            for(std::size_t i = first; i < last; ++i)
+                word |= std::uint64_t(!(vector[i] < threshold)) << (i - first);
+            bits[w] = word;
+        }
+    }
+
+    /**
+     * \brief Returns the Hamming distance between two signatures.
+     * \param bits1 first signature.
+     * \param bits2 second signature.
+     * \param num_words number of words of the signatures.
+     */
+    static std::size_t signatureDistance(const std::uint64_t* bits1,
+                                         const std::uint64_t* bits2,
+                                         const std::size_t num_words) {
+        std::size_t dist = 0;
+        for(std::size_t w = 0; w < num_words; ++w)
+            dist += std::popcount(bits1[w] ^ bits2[w]);
+        return dist;
+    }
+
+    /**
+     * \brief Returns true if two signatures differ in the bits
+     * `[first, first + count)`. Same as #affectSolution() over a block.
+     */
+    static bool signaturesDiffer(const std::uint64_t* bits1,
+                                 const std::uint64_t* bits2,
+                                 const std::size_t first,
+                                 const std::size_t count) {
+        std::size_t bit = first;
+        const std::size_t end = first + count;
+        while(bit < end) {
+            const std::size_t w = bit / 64;
+            const std::size_t offset = bit % 64;
+            const std::size_t length = std::min<std::size_t>(64 - offset,
+                                                             end - bit);
+            if(((bits1[w] ^ bits2[w]) & bitMask(offset, length)) != 0)
+                return true;
+            bit += length;
+        }
+        return false;
+    }
+
+    /// Copies the bits `[first, first + count)` of `from` into `to`.
+    static void copySignatureBits(const std::uint64_t* from,
+                                  std::uint64_t* to,
+                                  const std::size_t first,
+                                  const std::size_t count) {
+        std::size_t bit = first;
+        const std::size_t end = first + count;
+        while(bit < end) {
+            const std::size_t w = bit / 64;
+            const std::size_t offset = bit % 64;
+            const std::size_t length = std::min<std::size_t>(64 - offset,
+                                                             end - bit);
+            const auto mask = bitMask(offset, length);
+            to[w] = (to[w] & ~mask) | (from[w] & mask);
+            bit += length;
+        }
+    }
+    ///@}
+
+protected:
+    /// Mask of `length` bits starting at `offset` (`offset + length <= 64`).
+    static std::uint64_t bitMask(const std::size_t offset,
+                                 const std::size_t length) {
+        return (length == 64)? ~std::uint64_t(0) :
+               ((std::uint64_t(1) << length) - 1) << offset;
+    }
+
 public:
     /// Threshold parameter used to rounding the values to 0 or 1.
     double threshold {0.5};
@@ -731,6 +923,8 @@ public:
 
 //----------------------------------------------------------------------------//
 
+class SampledKendallTauDistance;
+
 /**
  * \brief Kendall Tau distance between two vectors.
  *
@@ -738,6 +932,9 @@ public:
  * vectors. This version is not normalized.
  */
 class KendallTauDistance: public DistanceFunctionBase {
+    /// Shares the inversion counting.
+    friend class SampledKendallTauDistance;
+
 public:
     /// Default constructor.
     KendallTauDistance() = default;
@@ -747,6 +944,13 @@ public:
 
     /**
      * \brief Computes the Kendall Tau distance between two vectors.
+     *
+     * The distance is the number of pairs of ranks whose keys are in
+     * different order in each vector, i.e., the number of inversions of the
+     * second key order when read in the first key order. It is counted by
+     * merge sort, in `O(n log n)`, using scratch memory kept per thread.
+     * Ties are broken by position, as in argsort().
+     *
      * \param vector1 first vector
      * \param vector2 second vector
      */
@@ -757,35 +961,39 @@ public:
                                      "be the same!");
 
         const std::size_t size = vector1.size();
+        if(size < 2)
+            return 0.0;
 
-        std::vector<std::pair<double, std::size_t>> pairs_v1;
-        std::vector<std::pair<double, std::size_t>> pairs_v2;
-
-        pairs_v1.reserve(size);
-        std::size_t rank = 0;
-        for(const auto &v : vector1)
-            pairs_v1.emplace_back(v, ++rank);
-
-        pairs_v2.reserve(size);
-        rank = 0;
-        for(const auto &v : vector2)
-            pairs_v2.emplace_back(v, ++rank);
-
-        std::sort(begin(pairs_v1), end(pairs_v1));
-        std::sort(begin(pairs_v2), end(pairs_v2));
-
-        unsigned disagreements = 0;
-        for(std::size_t i = 0; i < size - 1; ++i) {
-            for(std::size_t j = i + 1; j < size; ++j) {
-                if((pairs_v1[i].second < pairs_v1[j].second
-                    && pairs_v2[i].second > pairs_v2[j].second) ||
-                   (pairs_v1[i].second > pairs_v1[j].second
-                    && pairs_v2[i].second < pairs_v2[j].second))
-                    ++disagreements;
-            }
-        }
+        auto& ws = buildSequence(vector1, vector2);
+        return double(countInversions(ws.sequence.data(), ws.buffer.data(),
+                                      size));
+    }
+
+    /**
+     * \brief Returns true if the Kendall Tau distance between two vectors
+     * is at least `min_distance`.
+     *
+     * The inversion count stops as soon as the distance is reached.
+     *
+     * \param vector1 first vector
+     * \param vector2 second vector
+     * \param min_distance the threshold.
+     */
+    virtual bool atLeast(const Chromosome& vector1, const Chromosome& vector2,
+                         const double min_distance) override {
+        if(vector1.size() != vector2.size())
+            throw std::runtime_error("The size of the vector must "
+                                     "be the same!");
+
+        const std::size_t size = vector1.size();
+        if(min_distance <= 0.0)
+            return true;
+        if(size < 2)
+            return false;
 
-        return double(disagreements);
+        auto& ws = buildSequence(vector1, vector2);
+        return double(countInversions(ws.sequence.data(), ws.buffer.data(),
+                                      size, min_distance)) >= min_distance;
     }
 
     /**
@@ -801,309 +1009,1378 @@ public:
 
     /**
      * \brief Returns true if the changing of the blocks of keys `v1` by the
-     *        blocks of keys `v2` affects the solution.
+     *        blocks of keys `v2` may affect the solution.
+     *
+     * Only the blocks are known here, so this method returns false only
+     * when all keys are the same. Whether the replacement changes the key
+     * order depends on the other keys of the chromosome, and it is checked
+     * by #blockChangesOrder().
      *
      * \param v1_begin begin of the first blocks of keys
      * \param v2_begin begin of the first blocks of keys
      * \param block_size number of keys to be considered.
-     *
-     * \todo This is the same implementation of Hamming. We need to figure out
-     *       how to do it properly.
      */
     virtual bool affectSolution(Chromosome::const_iterator v1_begin,
                                 Chromosome::const_iterator v2_begin,
                                 const std::size_t block_size) override {
-        return block_size == 1?
-              affectSolution(*v1_begin, *v2_begin) : true;
+        for(std::size_t i = 0; i < block_size; ++i, ++v1_begin, ++v2_begin) {
+            if(affectSolution(*v1_begin, *v2_begin))
+                return true;
+        }
+        return false;
     }
-};
-///@} distance_functions
 
-//----------------------------------------------------------------------------//
-// BRKGA Params class.
-//----------------------------------------------------------------------------//
+    /** \name Rankings
+     *
+     * A ranking keeps the keys of a chromosome sorted together with their
+     * positions, so that it tells in `O(b log n)` whether replacing a block
+     * of `b` keys changes the key order, i.e., the permutation induced by
+     * the chromosome. It is updated in `O(n)` when a block is replaced.
+     * As in argsort(), ties are broken by position.
+     */
+    ///@{
+    /// A key and its position.
+    using RankedKey = std::pair<Chromosome::value_type, std::size_t>;
 
-/**
- * \defgroup brkga_control_params BRKGA and Control Parameters
- */
-///@{
+    /// Ranking of the keys of a chromosome.
+    struct Ranking {
+        /// The keys, by position.
+        Chromosome keys {};
 
-/**
- * \brief Represents the BRKGA and IPR hyper-parameters.
- */
-class BrkgaParams {
-public:
-    /** \name BRKGA Hyper-parameters */
-    //@{
-    /// Number of elements in the population (> 0).
-    unsigned population_size {0};
+        /// The keys and their positions, in increasing order.
+        std::vector<RankedKey> sorted {};
 
-    /// Percentage of individuals to become the elite set (0.0, 1.0].
-    double elite_percentage {0.0};
+        /// Scratch memory with the current and new keys of a block.
+        std::vector<RankedKey> old_block {};
+        std::vector<RankedKey> new_block {};
+    };
 
-    /// Percentage of mutants to be inserted in the population (0.0, 1.0].
-    double mutants_percentage {0.0};
+    /// Builds the ranking of `vector`.
+    static void ranking(const Chromosome& vector, Ranking& rank) {
+        rank.keys = vector;
+        rank.sorted.resize(vector.size());
+        for(std::size_t i = 0; i < vector.size(); ++i)
+            rank.sorted[i] = RankedKey(vector[i], i);
+        std::sort(rank.sorted.begin(), rank.sorted.end());
+    }
 
-    /// Number of elite parents for mating (> 0).
-    unsigned num_elite_parents {0};
+    /**
+     * \brief Returns true if replacing the keys `[first, first + count)`
+     * of the ranked chromosome by `block` changes the key order.
+     *
+     * The order is kept if and only if the new keys of the block are in
+     * the same order as the current ones, and each new key has the same
+     * number of keys out of the block below it as the key it replaces.
+     *
+     * \param rank the ranking of the chromosome.
+     * \param block begin of the new keys.
+     * \param first position of the first key of the block.
+     * \param count number of keys of the block.
+     */
+    static bool blockChangesOrder(Ranking& rank,
+                                  Chromosome::const_iterator block,
+                                  const std::size_t first,
+                                  const std::size_t count) {
+        const auto& sorted = rank.sorted;
+        const auto position = [&](const RankedKey& key) {
+            return std::size_t(std::lower_bound(sorted.begin(), sorted.end(),
+                                                key) - sorted.begin());
+        };
 
-    /// Number of total parents for mating (> 0).
-    unsigned total_parents {0};
+        if(count == 1) {
+            const RankedKey old_key(rank.keys[first], first);
+            const RankedKey new_key(*block, first);
+            return position(old_key) !=
+                   position(new_key) - std::size_t(old_key < new_key);
+        }
 
-    /// Type of bias that will be used.
-    BiasFunctionType bias_type {BiasFunctionType::CONSTANT};
+        auto& old_block = rank.old_block;
+        auto& new_block = rank.new_block;
+        old_block.resize(count);
+        new_block.resize(count);
+        for(std::size_t k = 0; k < count; ++k, ++block) {
+            old_block[k] = RankedKey(rank.keys[first + k], first + k);
+            new_block[k] = RankedKey(*block, first + k);
+        }
+        std::sort(old_block.begin(), old_block.end());
+        std::sort(new_block.begin(), new_block.end());
 
-    /// Number of independent parallel populations (> 0).
-    unsigned num_independent_populations {0};
-    //@}
+        std::size_t num_below = 0;
+        for(std::size_t k = 0; k < count; ++k) {
+            if(old_block[k].second != new_block[k].second)
+                return true;
 
-    /** \name Path Relinking parameters */
-    //@{
-    /// Number of pairs of chromosomes to be tested to path relinking (> 0).
-    unsigned pr_number_pairs {0};
+            // Keys out of the block below the current and the new key.
+            while(num_below < count && old_block[num_below] < new_block[k])
+                ++num_below;
+            if(position(old_block[k]) - k !=
+               position(new_block[k]) - num_below)
+                return true;
+        }
+        return false;
+    }
 
-    /** Mininum distance between chromosomes selected to path-relinking.
-     * Value range depends on the used distance function.
+    /**
+     * \brief Replaces the keys `[first, first + count)` of the ranked
+     * chromosome by `block`.
      */
-    double pr_minimum_distance {0.0};
+    static void replaceBlock(Ranking& rank, Chromosome::const_iterator block,
+                             const std::size_t first,
+                             const std::size_t count) {
+        auto& sorted = rank.sorted;
+        auto& new_block = rank.new_block;
+        new_block.resize(count);
+        for(std::size_t k = 0; k < count; ++k, ++block) {
+            rank.keys[first + k] = *block;
+            new_block[k] = RankedKey(*block, first + k);
+        }
+        std::sort(new_block.begin(), new_block.end());
+
+        // Drop the current keys of the block, and merge the new ones from
+        // the back.
+        const auto last = std::remove_if(sorted.begin(), sorted.end(),
+            [&](const RankedKey& key) {
+                return key.second - first < count;
+            });
+        std::size_t i = std::size_t(last - sorted.begin());
+        std::size_t j = count;
+        for(std::size_t k = sorted.size(); j > 0; --k) {
+            if(i > 0 && new_block[j - 1] < sorted[i - 1])
+                sorted[k - 1] = sorted[--i];
+            else
+                sorted[k - 1] = new_block[--j];
+        }
+    }
+    ///@}
 
-    /// Path relinking type.
-    PathRelinking::Type pr_type {PathRelinking::Type::DIRECT};
+protected:
+    /// Scratch memory of distance(), one per thread.
+    struct Workspace {
+        ArgSortWorkspace argsort_workspace {};
+        std::vector<unsigned> order1 {};
+        std::vector<unsigned> order2 {};
+        std::vector<unsigned> sequence {};
+        std::vector<unsigned> buffer {};
+    };
 
-    /// Individual selection to path-relinking.
-    PathRelinking::Selection pr_selection {PathRelinking::Selection::BESTSOLUTION};
+    /**
+     * \brief Builds, in the workspace of this thread, the sequence whose
+     * inversions are the distance between `vector1` and `vector2`: the
+     * position of the k-th smallest key of `vector2`, in the order of the
+     * positions of the keys of `vector1`.
+     */
+    static Workspace& buildSequence(const Chromosome& vector1,
+                                    const Chromosome& vector2) {
+        static thread_local Workspace workspace;
+        auto& ws = workspace;
 
-    /// Type of the distance function used on path-relinking.
-    PathRelinking::DistanceFunctionType pr_distance_function_type
-        {PathRelinking::DistanceFunctionType::CUSTOM};
+        argsort(vector1, ws.order1, ws.argsort_workspace);
+        argsort(vector2, ws.order2, ws.argsort_workspace);
 
-    /// The distance functor used on path-relinking.
-    std::shared_ptr<DistanceFunctionBase> pr_distance_function {};
+        const std::size_t size = vector1.size();
+        ws.sequence.resize(size);
+        for(std::size_t k = 0; k < size; ++k)
+            ws.sequence[ws.order1[k]] = ws.order2[k];
 
-    /// Defines the block size based on the size of the population (> 0).
-    double alpha_block_size {0.0};
+        ws.buffer.resize(size);
+        return ws;
+    }
 
-    /// Percentage / path size to be computed (0.0, 1.0].
-    double pr_percentage {0.0};
-    //@}
+    /**
+     * \brief Counts the inversions of `values` by a bottom-up merge sort.
+     * \param values the values. They are scrambled at the end.
+     * \param buffer scratch array with at least `size` positions.
+     * \param size number of values.
+     * \param limit the count stops once it reaches this value, returning
+     *        a partial count (at least `limit`).
+     */
+    static std::uint64_t countInversions(unsigned* values, unsigned* buffer,
+                        const std::size_t size,
+                        const double limit =
+                            std::numeric_limits<double>::infinity()) {
+        std::uint64_t inversions = 0;
+        unsigned* from = values;
+        unsigned* to = buffer;
+
+        for(std::size_t width = 1; width < size; width *= 2) {
+            if(double(inversions) >= limit)
+                break;
+            for(std::size_t left = 0; left < size; left += 2 * width) {
+                const std::size_t middle = std::min(left + width, size);
+                const std::size_t right = std::min(left + 2 * width, size);
+
+                std::size_t i = left, j = middle, k = left;
+                while(i < middle && j < right) {
+                    if(from[j] < from[i]) {
+                        // from[j] is smaller than all remaining on the left.
+                        inversions += middle - i;
+                        to[k++] = from[j++];
+                    }
+                    else
+                        to[k++] = from[i++];
+                }
+                while(i < middle)
+                    to[k++] = from[i++];
+                while(j < right)
+                    to[k++] = from[j++];
+            }
+            std::swap(from, to);
+        }
+        return inversions;
+    }
+};
 
-    /** \name Population exchange parameters */
-    //@{
-    /// Number of elite chromosomes exchanged from each population (> 0).
-    unsigned num_exchange_individuals {0};
-    //@}
+//----------------------------------------------------------------------------//
 
-    /** \name Shaking parameters */
-    //@{
-    /// Type of the shaking procedure.
-    ShakingType shaking_type {ShakingType::CHANGE};
+/**
+ * \brief Kendall Tau distance between the keys of two vectors, estimated
+ * from a sample of pairs of positions.
+ *
+ * This functor counts the pairs of positions whose keys are in different
+ * order in each vector. It is not an estimate of KendallTauDistance, which
+ * counts the pairs of ranks whose positions are in different order, i.e.,
+ * the same distance between the key orders of the vectors. Such pairs
+ * cannot be sampled without sorting the keys. Both distances range from
+ * zero, for chromosomes inducing the same permutation, to `n (n - 1) / 2`,
+ * but they differ in general, so a minimum distance tuned for one of them
+ * does not carry over to the other.
+ *
+ * For long chromosomes, even the `O(n log n)` exact distance is costly when
+ * computed many times. This functor checks only a fixed sample of pairs of
+ * positions, and scales the fraction of pairs in different order in each
+ * vector to the `n (n - 1) / 2` pairs. The sample has
+ * `ceil(ln(2 / failure_probability) / (2 max_error^2))` pairs, so that, by
+ * Hoeffding's inequality, the estimate is within
+ * `max_error * n (n - 1) / 2` of the exact distance with probability at
+ * least `1 - failure_probability`, whatever the chromosome size.
+ *
+ * The pairs are derived from `seed`, so the sample is the same for all
+ * comparisons of a run. When the chromosome has no more pairs than the
+ * sample, the exact distance is computed instead. The functor built by
+ * readConfiguration() takes the seed of the algorithm (see
+ * #use_algorithm_seed).
+ */
+class SampledKendallTauDistance: public DistanceFunctionBase {
+public:
+    /**
+     * \brief Default constructor.
+     * \param _max_error maximum error of the estimate, as a fraction of the
+     *        number of pairs.
+     * \param _failure_probability probability of the estimate exceeding
+     *        the error.
+     * \param _seed seed of the sample.
+     */
+    explicit SampledKendallTauDistance(
+                                const double _max_error = 0.01,
+                                const double _failure_probability = 1e-3,
+                                const std::uint64_t _seed = 2700001):
+        max_error {_max_error},
+        failure_probability {_failure_probability},
+        seed {_seed} {}
 
-    /** \brief Shaking intensity lower bound (0.0, 1.0].
-     *
-     * For default CHANGE and SWAP
-     * procedures, this value is a percentage of the chromosome size.
-     * If `shaking_intensity_lower_bound < shaking_intensity_upper_bound`,
-     * we uniformly draw a random intensity between these bounds on each
-     * shaking call.
-     * If `shaking_intensity_lower_bound = shaking_intensity_upper_bound`,
-     * then a fixed intensity is always used.
-     * See \ref BrkgaParams.shaking_intensity_upper_bound.
+    /// Default destructor.
+    virtual ~SampledKendallTauDistance() = default;
+
+    /// Returns the number of pairs of the sample.
+    std::size_t sampleSize() const {
+        return std::size_t(ceil(std::log(2.0 / failure_probability) /
+                                (2.0 * max_error * max_error)));
+    }
+
+    /**
+     * \brief Returns the maximum error of the distances between vectors of
+     * `size` keys, i.e., zero if they are exact.
      */
-    double shaking_intensity_lower_bound {0.0};
+    double maxError(const std::size_t size) const {
+        const double num_pairs = numPairs(size);
+        return (num_pairs <= double(sampleSize()))? 0.0 :
+               max_error * num_pairs;
+    }
 
-    /** \brief Shaking intensity upper bound (0.0, 1.0].
-     *
-     * For default CHANGE and SWAP
-     * procedures, this value is a percentage of the chromosome size.
-     * If `shaking_intensity_lower_bound < shaking_intensity_upper_bound`,
-     * we uniformly draw a random intensity between these bounds on each
-     * shaking call.
-     * If `shaking_intensity_lower_bound = shaking_intensity_upper_bound`,
-     * then a fixed intensity is always used.
-     * See \ref BrkgaParams.shaking_intensity_lower_bound.
+    /**
+     * \brief Estimates the number of pairs of positions whose keys are in
+     * different order in each vector.
+     * \param vector1 first vector
+     * \param vector2 second vector
      */
-    double shaking_intensity_upper_bound {0.0};
+    virtual double distance(const Chromosome& vector1,
+                            const Chromosome& vector2) override {
+        if(vector1.size() != vector2.size())
+            throw std::runtime_error("The size of the vector must "
+                                     "be the same!");
 
-    /** \brief This is the custom shaking procedure given by the user.
-     *
-     * - Parameters `lower_bound` and `upper_bound` is the shaking intensity
-     *   bounds to be applied. Usually, the define a range where the intensity
-     *   is sampled.
+        if(numPairs(vector1.size()) <= double(sampleSize()))
+            return exactDistance(vector1, vector2);
+        return estimate(vector1, vector2);
+    }
+
+    /**
+     * \brief Computes the exact distance estimated by this functor, in
+     * `O(n log n)`.
+     * \param vector1 first vector
+     * \param vector2 second vector
+     * \param limit the count stops once it reaches this value.
+     */
+    static double exactDistance(const Chromosome& vector1,
+                                const Chromosome& vector2,
+                                const double limit =
+                                    std::numeric_limits<double>::infinity()) {
+        const std::size_t size = vector1.size();
+        if(size < 2)
+            return 0.0;
+
+        static thread_local KendallTauDistance::Workspace workspace;
+        auto& ws = workspace;
+        argsort(vector1, ws.order1, ws.argsort_workspace);
+        argsort(vector2, ws.order2, ws.argsort_workspace);
+
+        // The rank of each key of vector2, read in the key order of
+        // vector1. The buffer holds the ranks meanwhile.
+        ws.buffer.resize(size);
+        for(std::size_t k = 0; k < size; ++k)
+            ws.buffer[ws.order2[k]] = unsigned(k);
+
+        ws.sequence.resize(size);
+        for(std::size_t k = 0; k < size; ++k)
+            ws.sequence[k] = ws.buffer[ws.order1[k]];
+
+        return double(KendallTauDistance::countInversions(ws.sequence.data(),
+                                                          ws.buffer.data(),
+                                                          size, limit));
+    }
+
+    /**
+     * \brief Returns true if the distance between two vectors is at least
+     * `min_distance`.
      *
-     * - Parameter `populations` are the current BRKGA populations.
+     * The answer comes from the estimate, unless it is within the error
+     * of `min_distance`. In that case, the exact distance is checked.
      *
-     * - Parameter `shaken` is a list of `<population index, chromosome index>`
-     *   pairs indicating which chromosomes were shaken on which population,
-     *   so that they got re-decoded.
-     *
-     * See BRKGA_MP_IPR::setShakingMethod() for details and examples.
-     *
-     * \note If `shaken` is empty, all chromosomes of all populations are
-     *      re-decoded. This may be slow. Even if you intention is to do so,
-     *      it is faster to populate `shaken`.
-     *
-     * \warning This procedure can be very intrusive since it must manipulate
-     *      the population. So, the user must make sure that BRKGA invariants
-     *      are kept, such as chromosome size and population size.
-     *      Otherwise, the overall functionaly may be compromised.
+     * \param vector1 first vector
+     * \param vector2 second vector
+     * \param min_distance the threshold.
      */
-    std::function<void(
-        double lower_bound,
-        double upper_bound,
-        std::vector<std::shared_ptr<Population>>& populations,
-        std::vector<std::pair<unsigned, unsigned>>& shaken
-    )> custom_shaking {};
-    //@}
+    virtual bool atLeast(const Chromosome& vector1, const Chromosome& vector2,
+                         const double min_distance) override {
+        if(vector1.size() != vector2.size())
+            throw std::runtime_error("The size of the vector must "
+                                     "be the same!");
 
-    /// Default constructor.
-    BrkgaParams() = default;
+        if(min_distance <= 0.0)
+            return true;
 
-    /// Destructor.
-    ~BrkgaParams() __attribute__((noinline)) = default;
+        const double tolerance = maxError(vector1.size());
+        if(tolerance > 0.0) {
+            const double value = estimate(vector1, vector2);
+            if(value >= min_distance + tolerance)
+                return true;
+            if(value < min_distance - tolerance)
+                return false;
+        }
+        return exactDistance(vector1, vector2, min_distance) >= min_distance;
+    }
+
+    /**
+     * \brief Returns true if the changing of `key1` by `key2` may affect
+     *        the solution.
+     * \param key1 the first key
+     * \param key2 the second key
+     */
+    virtual bool affectSolution(const Chromosome::value_type key1,
+                                const Chromosome::value_type key2) override {
+        return fabs(key1 - key2) > 1e-6;
+    }
+
+    /**
+     * \brief Returns true if the changing of the blocks of keys `v1` by the
+     *        blocks of keys `v2` may affect the solution.
+     * \param v1_begin begin of the first blocks of keys
+     * \param v2_begin begin of the first blocks of keys
+     * \param block_size number of keys to be considered.
+     */
+    virtual bool affectSolution(Chromosome::const_iterator v1_begin,
+                                Chromosome::const_iterator v2_begin,
+                                const std::size_t block_size) override {
+        for(std::size_t i = 0; i < block_size; ++i, ++v1_begin, ++v2_begin) {
+            if(affectSolution(*v1_begin, *v2_begin))
+                return true;
+        }
+        return false;
+    }
+
+protected:
+    /// Number of pairs of positions of `size` keys.
+    static double numPairs(const std::size_t size) {
+        return (size < 2)? 0.0 : double(size) * double(size - 1) / 2.0;
+    }
+
+    /// Estimates the distance from the sample. Requires at least two keys.
+    double estimate(const Chromosome& vector1,
+                    const Chromosome& vector2) const {
+        const std::size_t size = vector1.size();
+        const std::size_t sample_size = sampleSize();
+
+        std::size_t discordant = 0;
+        for(std::size_t k = 0; k < sample_size; ++k) {
+            // Pair k of the sample: a position and a different one.
+            const std::uint64_t hash =
+                mix(seed + (k + 1) * 0x9e3779b97f4a7c15ULL);
+            std::size_t i = std::size_t((hash & 0xffffffffULL) % size);
+            std::size_t j = std::size_t((hash >> 32) % (size - 1));
+            if(j >= i)
+                ++j;
+            if(j < i)
+                std::swap(i, j);
+
+            // As in argsort(), ties are broken by position.
+            discordant += (vector1[j] < vector1[i]) !=
+                          (vector2[j] < vector2[i]);
+        }
+        return double(discordant) / double(sample_size) * numPairs(size);
+    }
+
+    /// SplitMix64 finalizer.
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+public:
+    /// Maximum error of the estimate, as a fraction of the number of pairs.
+    double max_error {0.01};
+
+    /// Probability of the estimate exceeding the maximum error.
+    double failure_probability {1e-3};
+
+    /// Seed of the sample.
+    std::uint64_t seed {2700001};
+
+    /**
+     * \brief If true, BRKGA_MP_IPR replaces #seed by its own seed, so that
+     * the sample changes with the seed of the run. Set by
+     * readConfiguration().
+     */
+    bool use_algorithm_seed {false};
 };
+///@} distance_functions
 
 //----------------------------------------------------------------------------//
-// Control Parameters class.
+// Path relinking pair sampler
 //----------------------------------------------------------------------------//
 
 /**
- * \brief Represents additional control parameters that can be used outside this
- * framework.
+ * \brief Draws pairs `(i, j)` of elite positions, to be used as base and
+ * guide of the path relinking, without materializing them.
  *
- * These parameters are not used directly in the BRKGA nor in the path
- * relinking. However, they are loaded from the configuration file and can be
- * called by the user to perform out-loop controlling.
+ * Each pair is drawn at most once, in constant memory, and each draw costs
+ * `O(1)` (expected, for random sampling). When both positions come from the
+ * same population, pairs with `i == j` are skipped. Two orders are supported:
+ *
+ * - best-first: pairs are visited by increasing `i + j`, i.e., pairs of
+ *   better ranked individuals come first;
+ * - random: pairs are visited in the order given by a random permutation of
+ *   the pair indices. The permutation is a keyed Feistel network, restricted
+ *   to the pair indices by cycle walking, so nothing is stored per pair.
+ *
+ * This class is used internally by BRKGA_MP_IPR only.
  */
-class ControlParams {
+class IprPairSampler {
 public:
-    /// Maximum running time.
-    std::chrono::seconds maximum_running_time {0};
-
     /**
-     * \brief Interval / number of interations without improvement in the best
-     * solution at which elite chromosomes are exchanged (0 means no exchange).
+     * \brief Restarts the sampling.
+     * \param _size number of elite positions on each side.
+     * \param _skip_same if true, pairs `(i, i)` are not drawn.
+     * \param _random if true, the pairs are drawn at random. Otherwise,
+     *        they are drawn best-first.
+     * \param rng used to draw the keys of the random permutation.
      */
-    unsigned exchange_interval {0};
+    void reset(const std::size_t _size, const bool _skip_same,
+               const bool _random, std::mt19937& rng) {
+        size = _size;
+        skip_same = _skip_same;
+        random = _random;
+        num_pairs = size * size - (skip_same? size : 0);
+        num_drawn = 0;
+
+        if(random) {
+            half_bits = 1;
+            while((std::uint64_t(1) << (2 * half_bits)) < num_pairs)
+                ++half_bits;
+            for(auto& key : round_keys)
+                key = (std::uint64_t(rng()) << 32) | rng();
+            next_index = 0;
+        }
+        else {
+            diagonal = 0;
+            row = 0;
+        }
+    }
 
-    /**
-     * \brief Interval / number of interations without improvement in the best
-     * solution at which the Implicit Path Relink is called (0 means no IPR).
-     */
-    unsigned ipr_interval {0};
+    /// Returns the number of pairs to be drawn in total.
+    std::size_t numPairs() const { return num_pairs; }
+
+    /// Returns true if all pairs were drawn.
+    bool empty() const { return num_drawn == num_pairs; }
 
     /**
-     * \brief Interval / number of interations without improvement in the best
-     * solution at which the populations are shaken (0 means no shake).
+     * \brief Draws the next pair.
+     * \returns the base and guide positions.
+     * \warning The sampler must not be empty().
      */
-    unsigned shake_interval {0};
+    std::pair<std::size_t, std::size_t> next() {
+        ++num_drawn;
+        return random? nextRandom() : nextBestFirst();
+    }
+
+protected:
+    /// Next pair by increasing `i + j`, and increasing `i` on ties.
+    std::pair<std::size_t, std::size_t> nextBestFirst() {
+        while(true) {
+            const std::size_t first_row =
+                (diagonal < size)? 0 : diagonal - size + 1;
+            const std::size_t last_row = std::min(diagonal, size - 1);
+
+            if(row < first_row)
+                row = first_row;
+            if(row > last_row) {
+                ++diagonal;
+                row = 0;
+                continue;
+            }
+
+            const std::size_t i = row++;
+            const std::size_t j = diagonal - i;
+            if(skip_same && i == j)
+                continue;
+            return {i, j};
+        }
+    }
+
+    /// Next pair of the random permutation.
+    std::pair<std::size_t, std::size_t> nextRandom() {
+        std::uint64_t index;
+        do {
+            index = permute(next_index++);
+        } while(index >= num_pairs);
+
+        if(!skip_same)
+            return {index / size, index % size};
+
+        // Row `i` holds all columns but `i`.
+        const std::size_t i = index / (size - 1);
+        std::size_t j = index % (size - 1);
+        if(j >= i)
+            ++j;
+        return {i, j};
+    }
+
+    /// Four-round Feistel network over `2 * half_bits` bits.
+    std::uint64_t permute(const std::uint64_t value) const {
+        const std::uint64_t mask = (std::uint64_t(1) << half_bits) - 1;
+        std::uint64_t left = value >> half_bits;
+        std::uint64_t right = value & mask;
+        for(const auto key : round_keys) {
+            const std::uint64_t next_right = left ^ (mix(right ^ key) & mask);
+            left = right;
+            right = next_right;
+        }
+        return (left << half_bits) | right;
+    }
+
+    /// SplitMix64 finalizer.
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+protected:
+    /// Number of elite positions on each side.
+    std::size_t size {0};
+
+    /// Indicates whether pairs `(i, i)` are skipped.
+    bool skip_same {false};
+
+    /// Indicates whether the pairs are drawn at random.
+    bool random {false};
+
+    /// Number of pairs to be drawn, and already drawn.
+    std::size_t num_pairs {0};
+    std::size_t num_drawn {0};
+
+    /// Current anti-diagonal (`i + j`) and row (best-first).
+    std::size_t diagonal {0};
+    std::size_t row {0};
+
+    /// Bits of each half of the permuted indices (random).
+    unsigned half_bits {1};
+
+    /// Keys of the Feistel rounds (random).
+    std::array<std::uint64_t, 4> round_keys {};
+
+    /// Next index to be permuted (random).
+    std::uint64_t next_index {0};
+};
+
+//----------------------------------------------------------------------------//
+// Path relinking block size tuner
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Chooses the block size of successive path relinking calls, trying
+ * to maximize the improvements per second.
+ *
+ * The candidate sizes are the initial one, doubled and halved while they
+ * are within the given limits. Each size is tried once, starting from the
+ * initial one and moving outwards. Then, sizes are chosen by the UCB1 rule:
+ * the improvement rate of each size, relative to the best rate, plus an
+ * exploration bonus that shrinks as the size is used. An improvement of the
+ * best solution counts as two, and one of an elite solution counts as one.
+ *
+ * This class is used internally by BRKGA_MP_IPR only.
+ */
+class BlockSizeTuner {
+public:
+    /// Statistics of one candidate block size.
+    struct Arm {
+        /// The block size.
+        std::size_t block_size {1};
+
+        /// Number of calls using this size.
+        unsigned num_calls {0};
+
+        /// Total number of decodings of these calls.
+        std::size_t num_decodes {0};
+
+        /// Total time of these calls (in seconds).
+        double seconds {0.0};
+
+        /// Total score of the improvements of these calls.
+        double score {0.0};
+    };
 
     /**
-     * \brief Interval / number of interations without improvement in the best
-     * solution at which the populations are reset (0 means no reset).
+     * \brief Restarts the tuning.
+     * \param initial the initial block size.
+     * \param min_size the smallest block size (> 0).
+     * \param max_size the largest block size.
      */
-    unsigned reset_interval {0};
+    void reset(std::size_t initial, const std::size_t min_size,
+               std::size_t max_size) {
+        max_size = std::max(max_size, min_size);
+        initial = std::clamp(initial, min_size, max_size);
+
+        arms.clear();
+        for(std::size_t size = initial; size >= min_size; size /= 2) {
+            arms.insert(arms.begin(), Arm {});
+            arms.front().block_size = size;
+            if(size == 1)
+                break;
+        }
+        initial_arm = arms.size() - 1;
+
+        for(std::size_t size = initial * 2; size <= max_size; size *= 2) {
+            arms.emplace_back();
+            arms.back().block_size = size;
+        }
+
+        current_arm = initial_arm;
+        num_calls = 0;
+    }
+
+    /// Returns the block size of the next call.
+    std::size_t next() {
+        // Untried sizes first, from the initial one outwards.
+        for(std::size_t offset = 0; offset < arms.size(); ++offset) {
+            for(const std::size_t arm : {initial_arm - offset,
+                                         initial_arm + offset}) {
+                if(arm < arms.size() && arms[arm].num_calls == 0) {
+                    current_arm = arm;
+                    return arms[arm].block_size;
+                }
+            }
+        }
+
+        double best_rate = 0.0;
+        for(const auto& arm : arms)
+            best_rate = std::max(best_rate, rate(arm));
+
+        double best_value = -1.0;
+        for(std::size_t i = 0; i < arms.size(); ++i) {
+            const double value =
+                ((best_rate > 0.0)? rate(arms[i]) / best_rate : 0.0) +
+                sqrt(2.0 * log(double(num_calls)) / arms[i].num_calls);
+            if(value > best_value) {
+                best_value = value;
+                current_arm = i;
+            }
+        }
+        return arms[current_arm].block_size;
+    }
 
     /**
-     * \brief Defines the numbers iterations to stop when the best solution is
-     * not improved, i.e., the algorithm converged (0 means don't stop by stall).
+     * \brief Records the outcome of the last call, whose block size was
+     *        given by next().
+     * \param num_decodes number of decodings of the call.
+     * \param seconds duration of the call.
+     * \param result result of the call.
      */
-    unsigned stall_offset {0};
+    void update(const std::size_t num_decodes, const double seconds,
+                const PathRelinking::PathRelinkingResult result) {
+        using PR = PathRelinking::PathRelinkingResult;
+
+        auto& arm = arms[current_arm];
+        ++arm.num_calls;
+        arm.num_decodes += num_decodes;
+        arm.seconds += seconds;
+        if(result == PR::BEST_IMPROVEMENT)
+            arm.score += 2.0;
+        else
+        if(result == PR::ELITE_IMPROVEMENT)
+            arm.score += 1.0;
+        ++num_calls;
+    }
 
-    /// Default constructor.
-    ControlParams() = default;
+    /// Returns the statistics of the candidate block sizes.
+    const std::vector<Arm>& getArms() const { return arms; }
 
-    /// Destructor.
-    ~ControlParams() __attribute__((noinline)) = default;
+protected:
+    /// Improvements per second of a size. Very short calls count as 1 ms.
+    static double rate(const Arm& arm) {
+        return arm.score / std::max(arm.seconds, 1e-3 * arm.num_calls);
+    }
+
+    /// The candidate block sizes, by increasing size.
+    std::vector<Arm> arms {};
+
+    /// The initial block size and the one of the last call.
+    std::size_t initial_arm {0};
+    std::size_t current_arm {0};
+
+    /// Number of calls recorded.
+    unsigned num_calls {0};
 };
 
 //----------------------------------------------------------------------------//
-// Loading the parameters from file
+// Path relinking pair memory
 //----------------------------------------------------------------------------//
 
 /**
- * \brief Reads the parameters from an input stream.
+ * \brief Remembers the most recently relinked pairs of elite chromosomes,
+ * so identical paths are not walked again.
  *
- * \param input the input stream. It can be a file or a string stream.
- * \param logger a output stream to log some information such as missing
- *               no-required parameters. It does not log errors.
- * \returns a tuple containing the BRKGA and external control parameters.
- * \throws std::fstream::failure in case of errors in the file.
+ * Each relinking is identified by a key built from the fingerprints of its
+ * base and guide chromosomes, and from the parameters that shape its path.
+ * Once the memory is full, the oldest key is forgotten. The capacity is
+ * expected to be small, so the keys are searched linearly, and no memory
+ * is allocated after construction.
  *
- * \todo This method can beneficiate from introspection tools.
- *       We would like achieve a code similar to the
- *       [Julia counterpart](<https://github.com/ceandrade/brkga_mp_ipr_julia>).
+ * This class is used internally by BRKGA_MP_IPR only.
  */
-INLINE std::pair<BrkgaParams, ControlParams>
-readConfiguration(std::istream& input, std::ostream& logger = std::cout) {
-
-    // A simple struct to verify whether the parameter was correct loaded.
-    class AuxParam {
-    public:
-        // Indicates if the param is required.
-        bool required {false};
+class RelinkedPairMemory {
+public:
+    /**
+     * \brief Default constructor.
+     * \param _capacity maximum number of keys remembered. Zero disables
+     *        the memory.
+     */
+    explicit RelinkedPairMemory(const std::size_t _capacity = 0):
+        capacity(_capacity)
+    {
+        keys.reserve(capacity);
+    }
 
-        // Indicates if the param was supplied.
-        bool supplied {false};
+    /**
+     * \brief Builds the key of a relinking.
+     * \param base_id fingerprint of the base chromosome.
+     * \param guide_id fingerprint of the guide chromosome.
+     * \param pr_type type of the path relinking.
+     * \param block_size block size of the path relinking. Not used by the
+     *        permutation-based one, so it is not part of its keys. Zero
+     *        leaves it out of the key, i.e., all sizes share the key.
+     * \param percentage percentage of the path walked.
+     */
+    static std::uint64_t key(const std::uint64_t base_id,
+                             const std::uint64_t guide_id,
+                             const PathRelinking::Type pr_type,
+                             const std::size_t block_size,
+                             const double percentage) {
+        const std::uint64_t shape =
+            (pr_type == PathRelinking::Type::DIRECT)? block_size + 1 : 0;
+
+        std::uint64_t hash = base_id;
+        for(const auto value : {guide_id, shape,
+                                std::bit_cast<std::uint64_t>(percentage)})
+            hash = mix(hash * 0x9e3779b97f4a7c15ULL + value);
+        return hash;
+    }
 
-        // This wil be a wrapper lambda function to set the parameter.
-        std::function<void()> setter {};
+    /// Returns true if the key is remembered.
+    bool contains(const std::uint64_t key) const {
+        return std::find(keys.begin(), keys.end(), key) != keys.end();
+    }
 
-        // Constructor.
-        AuxParam(bool _required, std::function<void()> _setter):
-            required {_required},
-            supplied {false},
-            setter {_setter}
-            {}
+    /// Remembers a key, forgetting the oldest one if the memory is full.
+    void insert(const std::uint64_t key) {
+        if(capacity == 0 || contains(key))
+            return;
 
-        // Just call `setter()` and adjust the supplied flag.
-        // Note that `setter()` will handle the errors.
-        void set() {
-            setter();
-            supplied = true;
+        if(keys.size() < capacity) {
+            keys.push_back(key);
+            return;
         }
-    };
+        keys[oldest] = key;
+        oldest = (oldest + 1) % capacity;
+    }
 
-    // We have to declare here so that this variables are captured by
-    // the following lambda functions.
-    std::string token, data;
-    unsigned line_count;
+    /// Forgets all keys.
+    void clear() {
+        keys.clear();
+        oldest = 0;
+    }
 
-    // This is a setter function used to parse and test each parameter.
-    auto set_param = [&](auto& param_value) {
-        std::stringstream data_stream(data);
-        if(!(data_stream >> param_value)) {
-            std::stringstream error_msg;
-            error_msg
-            << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
-            << "Invalid value for '" << token << "' on config line "
-            << line_count << ": '" << data;
-            throw std::fstream::failure(error_msg.str());
-        }
-    };
+    /// Returns the number of keys remembered.
+    std::size_t size() const { return keys.size(); }
 
-    // Now, we build the full parameter map.
-    BrkgaParams brkga_params;
-    ControlParams control_params;
+    /// Returns the maximum number of keys remembered.
+    std::size_t getCapacity() const { return capacity; }
 
-    std::unordered_map<std::string, AuxParam> token_map {{
-        // Required.
-        {"population_size",
-          AuxParam {true, [&]() { set_param(brkga_params.population_size); }} },
-        {"elite_percentage",
-         AuxParam {true, [&]() { set_param(brkga_params.elite_percentage); }} },
-        {"mutants_percentage",
-          AuxParam {true, [&]() { set_param(brkga_params.mutants_percentage); }} },
-        {"population_size",
-         AuxParam {true, [&] { set_param(brkga_params.population_size); }} },
-        {"elite_percentage",
-         AuxParam {true, [&] { set_param(brkga_params.elite_percentage); }} },
-        {"mutants_percentage",
-         AuxParam {true, [&] { set_param(brkga_params.mutants_percentage); }} },
-        {"num_elite_parents",
-         AuxParam {true, [&] { set_param(brkga_params.num_elite_parents); }} },
-        {"total_parents",
-         AuxParam {true, [&] { set_param(brkga_params.total_parents); }} },
-        {"bias_type",
+protected:
+    /// SplitMix64 finalizer.
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+protected:
+    /// Maximum number of keys remembered.
+    std::size_t capacity {0};
+
+    /// The keys remembered, in a circular buffer.
+    std::vector<std::uint64_t> keys {};
+
+    /// Position of the oldest key, once the buffer is full.
+    std::size_t oldest {0};
+};
+
+//----------------------------------------------------------------------------//
+// Surrogate models
+//----------------------------------------------------------------------------//
+
+/**
+ * \defgroup surrogate_models Surrogate models
+ *
+ * Cheap models that estimate the fitness of chromosomes, trained online from
+ * decoded chromosomes. Used to pre-screen offspring during the evolution
+ * (see BRKGA_MP_IPR::setSurrogateModel()).
+ */
+///@{
+
+/**
+ * \brief Surrogate Model Base.
+ *
+ * This class is an interface for models that estimate the fitness of
+ * chromosomes without decoding them.
+ */
+class SurrogateModelBase {
+public:
+    /// Default constructor.
+    SurrogateModelBase() = default;
+
+    /// Default destructor.
+    virtual ~SurrogateModelBase() = default;
+
+    /**
+     * \brief Adds a decoded chromosome to the training data.
+     * Never called concurrently.
+     *
+     * \param chromosome the decoded chromosome.
+     * \param fitness its true fitness.
+     */
+    virtual void update(const Chromosome& chromosome,
+                        const fitness_t fitness) = 0;
+
+    /// Returns true if the model has enough data to estimate fitness.
+    virtual bool ready() const = 0;
+
+    /**
+     * \brief Estimates the fitness of a chromosome.
+     * It may be called concurrently from several threads, but never
+     * concurrently with update().
+     *
+     * \param chromosome the chromosome.
+     */
+    virtual fitness_t predict(const Chromosome& chromosome) const = 0;
+};
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief k-nearest neighbors surrogate model.
+ *
+ * Keeps the last `capacity` decoded chromosomes, and estimates the fitness of
+ * a chromosome as the average fitness of its `k` nearest neighbors in the
+ * Euclidean space of the keys. For non-scalar fitness (multi-objective), the
+ * fitness of the nearest neighbor is used. Each estimation takes
+ * O(capacity * chromosome size).
+ */
+class KNearestSurrogate: public SurrogateModelBase {
+public:
+    /**
+     * \brief Default constructor.
+     * \param _k number of neighbors.
+     * \param _capacity maximum number of chromosomes kept.
+     * \throws std::range_error if `_k` is zero or larger than `_capacity`.
+     */
+    explicit KNearestSurrogate(const unsigned _k = 5,
+                               const unsigned _capacity = 1000):
+        k {_k},
+        capacity {_capacity}
+    {
+        if(k == 0 || k > capacity)
+            throw std::range_error("The number of neighbors must be in "
+                                   "[1, capacity].");
+        samples.reserve(capacity);
+    }
+
+    /// Default destructor.
+    virtual ~KNearestSurrogate() {}
+
+    /// Adds a decoded chromosome, replacing the oldest one when full.
+    virtual void update(const Chromosome& chromosome,
+                        const fitness_t fitness) override {
+        if(samples.size() < capacity) {
+            samples.emplace_back(chromosome, fitness);
+        }
+        else {
+            samples[next_replacement] = std::make_pair(chromosome, fitness);
+            next_replacement = (next_replacement + 1) % capacity;
+        }
+    }
+
+    /// Returns true if there are at least `k` chromosomes.
+    virtual bool ready() const override {
+        return samples.size() >= k;
+    }
+
+    /// Estimates the fitness as the average of the `k` nearest neighbors.
+    virtual fitness_t predict(const Chromosome& chromosome) const override {
+        // Keep the k nearest as a max-heap over the distance.
+        std::vector<std::pair<double, std::size_t>> nearest;
+        nearest.reserve(k + 1);
+
+        for(std::size_t i = 0; i < samples.size(); ++i) {
+            const auto& keys = samples[i].first;
+            double dist = 0.0;
+            for(std::size_t j = 0; j < chromosome.size(); ++j) {
+                const double diff = chromosome[j] - keys[j];
+                dist += diff * diff;
+            }
+
+            if(nearest.size() < k) {
+                nearest.emplace_back(dist, i);
+                std::push_heap(nearest.begin(), nearest.end());
+            }
+            else
+            if(dist < nearest.front().first) {
+                std::pop_heap(nearest.begin(), nearest.end());
+                nearest.back() = std::make_pair(dist, i);
+                std::push_heap(nearest.begin(), nearest.end());
+            }
+        }
+
+        if constexpr(std::is_arithmetic_v<fitness_t>) {
+            double total = 0.0;
+            for(const auto& [dist, idx] : nearest)
+                total += samples[idx].second;
+            return static_cast<fitness_t>(total / nearest.size());
+        }
+        else {
+            std::sort_heap(nearest.begin(), nearest.end());
+            return samples[nearest.front().second].second;
+        }
+    }
+
+public:
+    /// Number of neighbors.
+    const unsigned k;
+
+    /// Maximum number of chromosomes kept.
+    const unsigned capacity;
+
+protected:
+    /// Decoded chromosomes and their fitness.
+    std::vector<std::pair<Chromosome, fitness_t>> samples {};
+
+    /// Index of the sample to be replaced when full.
+    std::size_t next_replacement {0};
+};
+///@} surrogate_models
+
+//----------------------------------------------------------------------------//
+// BRKGA Params class.
+//----------------------------------------------------------------------------//
+
+/**
+ * \defgroup brkga_control_params BRKGA and Control Parameters
+ */
+///@{
+
+/**
+ * \brief Represents the BRKGA and IPR hyper-parameters.
+ */
+class BrkgaParams {
+public:
+    /** \name BRKGA Hyper-parameters */
+    //@{
+    /// Number of elements in the population (> 0).
+    unsigned population_size {0};
+
+    /// Percentage of individuals to become the elite set (0.0, 1.0].
+    double elite_percentage {0.0};
+
+    /// Percentage of mutants to be inserted in the population (0.0, 1.0].
+    double mutants_percentage {0.0};
+
+    /// Number of elite parents for mating (> 0).
+    unsigned num_elite_parents {0};
+
+    /// Number of total parents for mating (> 0).
+    unsigned total_parents {0};
+
+    /// Type of bias that will be used.
+    BiasFunctionType bias_type {BiasFunctionType::CONSTANT};
+
+    /// Number of independent parallel populations (> 0).
+    unsigned num_independent_populations {0};
+    //@}
+
+    /** \name Path Relinking parameters */
+    //@{
+    /// Number of pairs of chromosomes to be tested to path relinking (> 0).
+    unsigned pr_number_pairs {0};
+
+    /** Mininum distance between chromosomes selected to path-relinking.
+     * Value range depends on the used distance function.
+     */
+    double pr_minimum_distance {0.0};
+
+    /// Path relinking type.
+    PathRelinking::Type pr_type {PathRelinking::Type::DIRECT};
+
+    /// Individual selection to path-relinking.
+    PathRelinking::Selection pr_selection {PathRelinking::Selection::BESTSOLUTION};
+
+    /// Type of the distance function used on path-relinking.
+    PathRelinking::DistanceFunctionType pr_distance_function_type
+        {PathRelinking::DistanceFunctionType::CUSTOM};
+
+    /// The distance functor used on path-relinking.
+    std::shared_ptr<DistanceFunctionBase> pr_distance_function {};
+
+    /// Defines the block size based on the size of the population (> 0).
+    double alpha_block_size {0.0};
+
+    /// Percentage / path size to be computed (0.0, 1.0].
+    double pr_percentage {0.0};
+
+    /**
+     * \brief If true, the path relinking candidates are built on demand,
+     * one per decoding slot, instead of all at once. It bounds the memory to
+     * `O(max_threads * chromosome_size)`, regardless of the path size. Both
+     * ways walk the same path. Within an ask/tell session, the candidates
+     * are always built all at once.
+     */
+    bool pr_streaming {false};
+
+    /**
+     * \brief If true, the path relinking fills the decoding slots left
+     * idle at the end of each step with candidates of the next step,
+     * which moves the point of the other path. The path walked is the same,
+     * at the cost of one wasted decoding per step. Not used within an
+     * ask/tell session, nor with sampled neighborhoods (see
+     * #pr_neighborhood).
+     */
+    bool pr_speculative {false};
+
+    /**
+     * \brief If positive, the path relinking takes up to this number of
+     * qualifying elite pairs from each pair of populations, and walks all
+     * their paths at the same time, decoding the candidates of all paths in
+     * the same batches. Zero walks one path per pair of populations, one
+     * after the other.
+     */
+    unsigned pr_concurrent_pairs {0};
+
+    /**
+     * \brief Candidate moves decoded in each step of the path relinking.
+     * Sampling the moves cuts the cost of a full path from quadratic to
+     * about `O(num_moves^1.5)` decodings (SQUARE_ROOT) or linear (FIXED),
+     * at the cost of a greedier path.
+     */
+    PathRelinking::Neighborhood pr_neighborhood {
+        PathRelinking::Neighborhood::FULL
+    };
+
+    /// Number of moves decoded in each step when #pr_neighborhood is FIXED.
+    unsigned pr_neighborhood_size {0};
+
+    /**
+     * \brief If true, the block size of the path relinking calls made by
+     * BRKGA_MP_IPR::run() and the short BRKGA_MP_IPR::pathRelink() is tuned
+     * online to the size with most improvements per second, among sizes
+     * between #pr_min_block_size and #pr_max_block_size (see
+     * BlockSizeTuner). Otherwise, it is derived from #alpha_block_size.
+     */
+    bool pr_adaptive_block_size {false};
+
+    /// Smallest block size tried by the adaptive block size (> 0).
+    unsigned pr_min_block_size {1};
+
+    /// Largest block size tried by the adaptive block size. Zero means half
+    /// of the chromosome size.
+    unsigned pr_max_block_size {0};
+
+    /**
+     * \brief If positive, the path relinking remembers up to this number of
+     * the most recently relinked elite pairs, and skips the pairs whose path
+     * would be the same of a remembered one, i.e., same base and guide
+     * chromosomes, type, block size, and percentage. Zero disables the
+     * memory. Only used when #pr_neighborhood is FULL, since the sampled
+     * neighborhoods walk a different path each time.
+     *
+     * With #pr_adaptive_block_size, the block size changes from call to
+     * call, so it is left out of the comparison: a pair relinked recently
+     * with any block size is skipped.
+     */
+    unsigned pr_pair_memory_size {0};
+    //@}
+
+    /** \name Population exchange parameters */
+    //@{
+    /// Number of elite chromosomes exchanged from each population (> 0).
+    unsigned num_exchange_individuals {0};
+    //@}
+
+    /** \name Shaking parameters */
+    //@{
+    /// Type of the shaking procedure.
+    ShakingType shaking_type {ShakingType::CHANGE};
+
+    /** \brief Shaking intensity lower bound (0.0, 1.0].
+     *
+     * For default CHANGE and SWAP
+     * procedures, this value is a percentage of the chromosome size.
+     * If `shaking_intensity_lower_bound < shaking_intensity_upper_bound`,
+     * we uniformly draw a random intensity between these bounds on each
+     * shaking call.
+     * If `shaking_intensity_lower_bound = shaking_intensity_upper_bound`,
+     * then a fixed intensity is always used.
+     * See \ref BrkgaParams.shaking_intensity_upper_bound.
+     */
+    double shaking_intensity_lower_bound {0.0};
+
+    /** \brief Shaking intensity upper bound (0.0, 1.0].
+     *
+     * For default CHANGE and SWAP
+     * procedures, this value is a percentage of the chromosome size.
+     * If `shaking_intensity_lower_bound < shaking_intensity_upper_bound`,
+     * we uniformly draw a random intensity between these bounds on each
+     * shaking call.
+     * If `shaking_intensity_lower_bound = shaking_intensity_upper_bound`,
+     * then a fixed intensity is always used.
+     * See \ref BrkgaParams.shaking_intensity_lower_bound.
+     */
+    double shaking_intensity_upper_bound {0.0};
+
+    /** \brief This is the custom shaking procedure given by the user.
+     *
+     * - Parameters `lower_bound` and `upper_bound` is the shaking intensity
+     *   bounds to be applied. Usually, the define a range where the intensity
+     *   is sampled.
+     *
+     * - Parameter `populations` are the current BRKGA populations.
+     *
+     * - Parameter `shaken` is a list of `<population index, chromosome index>`
+     *   pairs indicating which chromosomes were shaken on which population,
+     *   so that they got re-decoded.
+     *
+     * See BRKGA_MP_IPR::setShakingMethod() for details and examples.
+     *
+     * \note If `shaken` is empty, all chromosomes of all populations are
+     *      re-decoded. This may be slow. Even if you intention is to do so,
+     *      it is faster to populate `shaken`.
+     *
+     * \warning This procedure can be very intrusive since it must manipulate
+     *      the population. So, the user must make sure that BRKGA invariants
+     *      are kept, such as chromosome size and population size.
+     *      Otherwise, the overall functionaly may be compromised.
+     */
+    std::function<void(
+        double lower_bound,
+        double upper_bound,
+        std::vector<std::shared_ptr<Population>>& populations,
+        std::vector<std::pair<unsigned, unsigned>>& shaken
+    )> custom_shaking {};
+    //@}
+
+    /// Default constructor.
+    BrkgaParams() = default;
+
+    /// Destructor.
+    ~BrkgaParams() __attribute__((noinline)) = default;
+};
+
+//----------------------------------------------------------------------------//
+// Control Parameters class.
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Represents additional control parameters that can be used outside this
+ * framework.
+ *
+ * These parameters are not used directly in the BRKGA nor in the path
+ * relinking. However, they are loaded from the configuration file and can be
+ * called by the user to perform out-loop controlling.
+ */
+class ControlParams {
+public:
+    /// Maximum running time.
+    std::chrono::seconds maximum_running_time {0};
+
+    /**
+     * \brief Interval / number of interations without improvement in the best
+     * solution at which elite chromosomes are exchanged (0 means no exchange).
+     */
+    unsigned exchange_interval {0};
+
+    /**
+     * \brief Interval / number of interations without improvement in the best
+     * solution at which the Implicit Path Relink is called (0 means no IPR).
+     */
+    unsigned ipr_interval {0};
+
+    /**
+     * \brief Interval / number of interations without improvement in the best
+     * solution at which the populations are shaken (0 means no shake).
+     */
+    unsigned shake_interval {0};
+
+    /**
+     * \brief Interval / number of interations without improvement in the best
+     * solution at which the populations are reset (0 means no reset).
+     */
+    unsigned reset_interval {0};
+
+    /**
+     * \brief Defines the numbers iterations to stop when the best solution is
+     * not improved, i.e., the algorithm converged (0 means don't stop by stall).
+     */
+    unsigned stall_offset {0};
+
+    /// Default constructor.
+    ControlParams() = default;
+
+    /// Destructor.
+    ~ControlParams() __attribute__((noinline)) = default;
+};
+
+//----------------------------------------------------------------------------//
+// Loading the parameters from file
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Reads the parameters from an input stream.
+ *
+ * \param input the input stream. It can be a file or a string stream.
+ * \param logger a output stream to log some information such as missing
+ *               no-required parameters. It does not log errors.
+ * \returns a tuple containing the BRKGA and external control parameters.
+ * \throws std::fstream::failure in case of errors in the file.
+ *
+ * \todo This method can beneficiate from introspection tools.
+ *       We would like achieve a code similar to the
+ *       [Julia counterpart](<https://github.com/ceandrade/brkga_mp_ipr_julia>).
+ */
+INLINE std::pair<BrkgaParams, ControlParams>
+readConfiguration(std::istream& input, std::ostream& logger = std::cout) {
+
+    // A simple struct to verify whether the parameter was correct loaded.
+    class AuxParam {
+    public:
+        // Indicates if the param is required.
+        bool required {false};
+
+        // Indicates if the param was supplied.
+        bool supplied {false};
+
+        // This wil be a wrapper lambda function to set the parameter.
+        std::function<void()> setter {};
+
+        // Constructor.
+        AuxParam(bool _required, std::function<void()> _setter):
+            required {_required},
+            supplied {false},
+            setter {_setter}
+            {}
+
+        // Just call `setter()` and adjust the supplied flag.
+        // Note that `setter()` will handle the errors.
+        void set() {
+            setter();
+            supplied = true;
+        }
+    };
+
+    // We have to declare here so that this variables are captured by
+    // the following lambda functions.
+    std::string token, data;
+    unsigned line_count;
+
+    // This is a setter function used to parse and test each parameter.
+    auto set_param = [&](auto& param_value) {
+        std::stringstream data_stream(data);
+        if(!(data_stream >> param_value)) {
+            std::stringstream error_msg;
+            error_msg
+            << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+            << "Invalid value for '" << token << "' on config line "
+            << line_count << ": '" << data;
+            throw std::fstream::failure(error_msg.str());
+        }
+    };
+
+    // Now, we build the full parameter map.
+    BrkgaParams brkga_params;
+    ControlParams control_params;
+
+    std::unordered_map<std::string, AuxParam> token_map {{
+        // Required.
+        {"population_size",
+          AuxParam {true, [&]() { set_param(brkga_params.population_size); }} },
+        {"elite_percentage",
+         AuxParam {true, [&]() { set_param(brkga_params.elite_percentage); }} },
+        {"mutants_percentage",
+          AuxParam {true, [&]() { set_param(brkga_params.mutants_percentage); }} },
+        {"population_size",
+         AuxParam {true, [&] { set_param(brkga_params.population_size); }} },
+        {"elite_percentage",
+         AuxParam {true, [&] { set_param(brkga_params.elite_percentage); }} },
+        {"mutants_percentage",
+         AuxParam {true, [&] { set_param(brkga_params.mutants_percentage); }} },
+        {"num_elite_parents",
+         AuxParam {true, [&] { set_param(brkga_params.num_elite_parents); }} },
+        {"total_parents",
+         AuxParam {true, [&] { set_param(brkga_params.total_parents); }} },
+        {"bias_type",
          AuxParam {true, [&] { set_param(brkga_params.bias_type); }} },
         {"num_independent_populations",
          AuxParam {true, [&] { set_param(brkga_params.num_independent_populations); }} },
@@ -1122,6 +2399,24 @@ readConfiguration(std::istream& input, std::ostream& logger = std::cout) {
         {"pr_percentage",
          AuxParam {true, [&] { set_param(brkga_params.pr_percentage); }} },
         // Optional.
+        {"pr_streaming",
+         AuxParam {false, [&] { set_param(brkga_params.pr_streaming); }} },
+        {"pr_speculative",
+         AuxParam {false, [&] { set_param(brkga_params.pr_speculative); }} },
+        {"pr_concurrent_pairs",
+         AuxParam {false, [&] { set_param(brkga_params.pr_concurrent_pairs); }} },
+        {"pr_neighborhood",
+         AuxParam {false, [&] { set_param(brkga_params.pr_neighborhood); }} },
+        {"pr_neighborhood_size",
+         AuxParam {false, [&] { set_param(brkga_params.pr_neighborhood_size); }} },
+        {"pr_adaptive_block_size",
+         AuxParam {false, [&] { set_param(brkga_params.pr_adaptive_block_size); }} },
+        {"pr_min_block_size",
+         AuxParam {false, [&] { set_param(brkga_params.pr_min_block_size); }} },
+        {"pr_max_block_size",
+         AuxParam {false, [&] { set_param(brkga_params.pr_max_block_size); }} },
+        {"pr_pair_memory_size",
+         AuxParam {false, [&] { set_param(brkga_params.pr_pair_memory_size); }} },
         {"num_exchange_individuals",
          AuxParam {false, [&] { set_param(brkga_params.num_exchange_individuals); }} },
         {"shaking_type",
@@ -1144,351 +2439,1002 @@ readConfiguration(std::istream& input, std::ostream& logger = std::cout) {
          AuxParam {false, [&] { set_param(control_params.stall_offset); }} }
     }};
 
-    std::string line;
-    line_count = 0;
-    while(std::getline(input, line)) {
-        ++line_count;
-        std::string::size_type pos = line.find_first_not_of(" \t\n\v");
+    std::string line;
+    line_count = 0;
+    while(std::getline(input, line)) {
+        ++line_count;
+        std::string::size_type pos = line.find_first_not_of(" \t\n\v");
+
+        // Ignore all comments and blank lines.
+        if(pos == std::string::npos || line[pos] == '#')
+            continue;
+
+        std::stringstream line_stream(line);
+        line_stream >> token >> data;
+
+        std::transform(token.begin(), token.end(), token.begin(), tolower);
+
+        if(auto it_token = token_map.find(token); it_token != token_map.end()) {
+            if(it_token->second.supplied) {
+                std::stringstream error_msg;
+                error_msg
+                << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+                << "Duplicate attribute on config line " << line_count
+                << ": '" << token << "' already read";
+                throw std::fstream::failure(error_msg.str());
+            }
+
+            it_token->second.set();
+        }
+        else {
+            std::stringstream error_msg;
+            error_msg
+            << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+            << "Invalid token on config line " << line_count
+            << ": '" << token << "'";
+            throw std::fstream::failure(error_msg.str());
+        }
+    }
+
+    // Check requeriments.
+    for(const auto& param : token_map) {
+        if(!param.second.supplied) {
+            if(param.second.required) {
+                std::stringstream error_msg;
+                error_msg
+                << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+                << "Parameter '" << param.first
+                << "' is required but it was not supplied in the config file";
+                throw std::fstream::failure(error_msg.str());
+            }
+            else {
+                std::stringstream error_msg;
+                error_msg
+                << "WARNING: parameter '" << param.first
+                << "' was not supplied in the config file. Using default value.";
+                logger << error_msg.str() << "\n";
+            }
+        }
+    }
+
+    // Check distance function for IPR.
+    switch(brkga_params.pr_distance_function_type) {
+    case PathRelinking::DistanceFunctionType::HAMMING:
+        brkga_params.pr_distance_function =
+            std::shared_ptr<DistanceFunctionBase> {new HammingDistance};
+        break;
+
+    case PathRelinking::DistanceFunctionType::KENDALLTAU:
+        brkga_params.pr_distance_function =
+            std::shared_ptr<DistanceFunctionBase> {new KendallTauDistance};
+        break;
+
+    case PathRelinking::DistanceFunctionType::SAMPLED_KENDALLTAU:
+        brkga_params.pr_distance_function =
+            std::shared_ptr<DistanceFunctionBase> {
+                new SampledKendallTauDistance};
+        // The seed is given by the algorithm.
+        std::static_pointer_cast<SampledKendallTauDistance>(
+            brkga_params.pr_distance_function)->use_algorithm_seed = true;
+        break;
+
+    default:
+        std::stringstream error_msg;
+        error_msg
+        << "WARNING: distance function set to '"
+        << brkga_params.pr_distance_function_type << "'. "
+        << "The user must supply his/her own distance functor if using IPR.";
+        logger << error_msg.str() << "\n";
+        break;
+    }
+
+    // Check shaking procedure.
+    if(brkga_params.shaking_type == ShakingType::CUSTOM) {
+        logger << "WARNING: shaking distance set to 'CUSTOM'. "
+                   "The user must supply his/her own if using shaking.";
+    }
+
+    return std::make_pair(std::move(brkga_params), std::move(control_params));
+}
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Reads the parameters from a configuration file.
+ *
+ * \param filename the configuration file.
+ * \param logger a output stream to log some information such as missing
+ *               no-required parameters. It does not log errors.
+ * \returns a tuple containing the BRKGA and external control parameters.
+ * \throws std::fstream::failure in case of errors in the file.
+ */
+INLINE std::pair<BrkgaParams, ControlParams>
+readConfiguration(const std::string& filename,
+                  std::ostream& logger = std::cout) {
+
+    std::ifstream input(filename, std::ios::in);
+    if(!input) {
+        std::stringstream error_msg;
+        error_msg << "File '" << filename << "' cannot be opened!";
+        throw std::fstream::failure(error_msg.str());
+    }
+    return readConfiguration(input, logger);
+}
+
+//----------------------------------------------------------------------------//
+// Writing the parameters into file
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Output stream operator for BrkgaParams.
+ *
+ * \param os the output stream.
+ * \param brkga_params the parameters.
+ * \return the output stream.
+ */
+INLINE std::ostream&
+operator<<(std::ostream& os, const BrkgaParams& brkga_params) {
+    os
+    << "population_size " << brkga_params.population_size << "\n"
+    << std::setiosflags(std::ios::fixed) << std::setprecision(2)
+    << "elite_percentage " << brkga_params.elite_percentage << "\n"
+    << "mutants_percentage " << brkga_params.mutants_percentage << "\n"
+    << "num_elite_parents " << brkga_params.num_elite_parents << "\n"
+    << "total_parents " << brkga_params.total_parents << "\n"
+    << "bias_type " << brkga_params.bias_type << "\n"
+    << "num_independent_populations "
+    << brkga_params.num_independent_populations << "\n"
+    << "pr_number_pairs " << brkga_params.pr_number_pairs << "\n"
+    << "pr_minimum_distance " << brkga_params.pr_minimum_distance << "\n"
+    << "pr_type " << brkga_params.pr_type << "\n"
+    << "pr_selection " << brkga_params.pr_selection << "\n"
+    << "pr_distance_function_type " << brkga_params.pr_distance_function_type << "\n"
+    << "alpha_block_size " << brkga_params.alpha_block_size << "\n"
+    << "pr_percentage " << brkga_params.pr_percentage << "\n"
+    << "pr_streaming " << brkga_params.pr_streaming << "\n"
+    << "pr_speculative " << brkga_params.pr_speculative << "\n"
+    << "pr_concurrent_pairs " << brkga_params.pr_concurrent_pairs << "\n"
+    << "pr_neighborhood " << brkga_params.pr_neighborhood << "\n"
+    << "pr_neighborhood_size " << brkga_params.pr_neighborhood_size << "\n"
+    << "pr_adaptive_block_size " << brkga_params.pr_adaptive_block_size
+    << "\n"
+    << "pr_min_block_size " << brkga_params.pr_min_block_size << "\n"
+    << "pr_max_block_size " << brkga_params.pr_max_block_size << "\n"
+    << "pr_pair_memory_size " << brkga_params.pr_pair_memory_size << "\n"
+    << "num_exchange_individuals "
+    << brkga_params.num_exchange_individuals << "\n"
+    << "shaking_type " << brkga_params.shaking_type << "\n"
+    << "shaking_intensity_lower_bound " << brkga_params.shaking_intensity_lower_bound << "\n"
+    << "shaking_intensity_upper_bound " << brkga_params.shaking_intensity_upper_bound << "\n";
+    return os;
+}
+
+/**
+ * \brief Output stream operator for ControlParams.
+ *
+ * \param os the output stream.
+ * \param control_params the parameters.
+ * \return the output stream.
+ */
+INLINE std::ostream&
+operator<<(std::ostream& os, const ControlParams& control_params) {
+    os
+    << "maximum_running_time " << control_params.maximum_running_time << "\n"
+    << "exchange_interval " << control_params.exchange_interval << "\n"
+    << "shake_interval " << control_params.shake_interval << "\n"
+    << "ipr_interval " << control_params.ipr_interval << "\n"
+    << "reset_interval " << control_params.reset_interval << "\n"
+    << "stall_offset " << control_params.stall_offset;
+    return os;
+}
+
+/**
+ * \brief Writes the parameters into a output stream.
+ *
+ * \note All floating point parameters are written with two point precision.
+ *
+ * \param output the output stream.
+ * \param brkga_params the BRKGA parameters.
+ * \param control_params the external control parameters. Default is an empty
+ *        object.
+ * \throws std::fstream::failure in case of errors in the file.
+ *
+ * \todo This method can beneficiate from introspection tools.
+ *       We would like achieve a code similar to the
+ *       [Julia counterpart](<https://github.com/ceandrade/brkga_mp_ipr_julia>).
+ */
+INLINE void writeConfiguration(std::ostream& output,
+        const BrkgaParams& brkga_params,
+        const ControlParams& control_params = ControlParams{}) {
+    output << brkga_params << control_params << "\n";
+}
+
+//----------------------------------------------------------------------------//
 
-        // Ignore all comments and blank lines.
-        if(pos == std::string::npos || line[pos] == '#')
-            continue;
+/**
+ * \brief Writes the parameters into a configuration file.
+ *
+ * \note All floating point parameters are written with two point precision.
+ *
+ * \param filename the configuration file.
+ * \param brkga_params the BRKGA parameters.
+ * \param control_params the external control parameters.
+ *        Default is an empty object.
+ * \throws std::fstream::failure in case of errors in the file.
+ */
+INLINE void writeConfiguration(const std::string& filename,
+        const BrkgaParams& brkga_params,
+        const ControlParams& control_params = ControlParams{}) {
+
+    std::ofstream output(filename, std::ios::out);
+    if(!output) {
+        std::stringstream error_msg;
+        error_msg << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+                  << "File '" << filename << "' cannot be opened!";
+        throw std::fstream::failure(error_msg.str());
+    }
+
+    writeConfiguration(output, brkga_params, control_params);
+    output.close();
+}
+///@} brkga_control_params
+
+//----------------------------------------------------------------------------//
+// Algorithm status
+//----------------------------------------------------------------------------//
+
+/**
+ * \defgroup algorithm_status Algorithm status utilities
+ */
+///@{
+
+/**
+ * \brief Defines the current status of the algorithm for a given
+ * BRKGA_MP_IPR::run() call.
+ *
+ * \note We use `std::chrono::duration<double>` instead `std::chrono::seconds`
+ *      for keep better precision.
+ */
+class AlgorithmStatus {
+public:
+    /** \name Best current solution */
+    //@{
+    /// Current best fitness value.
+    fitness_t best_fitness {};
+
+    /// A pointer to the current best chromosome.
+    Chromosome best_chromosome {};
+
+    /**
+     * \brief The solution payload attached by the decoder to the best
+     * chromosome, if any (see DecodeContext::setPayload()).
+     */
+    std::shared_ptr<const std::any> best_payload {};
+    //@}
+
+    /** \name General iteration counters */
+    //@{
+    /// The current algorithm iteration / generation.
+    unsigned current_iteration {0};
+
+    /// The iteration of the last update.
+    unsigned last_update_iteration {0};
+
+    /// The time of the last update (in seconds).
+    std::chrono::duration<double> current_time {0.0};
+
+    /// The time of the last update (in seconds).
+    std::chrono::duration<double> last_update_time {0.0};
+
+    /// The largest number of iterations between two updates.
+    unsigned largest_iteration_offset {0};
+
+    /// Last number of iterations without improvement in the best solution.
+    unsigned stalled_iterations {0};
+    //@}
+
+    /** \name Path relinking counters */
+    //@{
+    /// Total time spent on path relinking so far (in seconds).
+    std::chrono::duration<double> path_relink_time {0.0};
+
+    /// Number of call to path relinking.
+    unsigned num_path_relink_calls {0};
+
+    /** Number of homogenities, i.e., number of times that the populations are
+     * too homogenious and the path reliking could not be performed.
+     */
+    unsigned num_homogenities {0};
+
+    /// Number of improvements in the best solution by the path reliking.
+    unsigned num_best_improvements {0};
+
+    /** Number of improvements in elite individuals, but not the best one,
+     * by path reliking.
+     */
+    unsigned num_elite_improvements {0};
+
+    /// Number of candidate moves not decoded due to the sampled
+    /// neighborhoods (see BrkgaParams::pr_neighborhood).
+    unsigned num_path_relink_saved_decodes {0};
+
+    /// Number of elite pairs not relinked because their paths were walked
+    /// recently (see BrkgaParams::pr_pair_memory_size).
+    unsigned num_path_relink_skipped_pairs {0};
+    //@}
+
+    /** \name Exchange, reset, and shake counters */
+    //@{
+    /** Number of exchange between populations performed
+     * (not number of individuals).
+     */
+    unsigned num_exchanges {0};
+
+    /// Number of shakes performed.
+    unsigned num_shakes {0};
+
+    /// Number of population resets performed.
+    unsigned num_resets {0};
+    //@}
+
+    /** \name Surrogate counters (see BRKGA_MP_IPR::setSurrogateModel()) */
+    //@{
+    /// Number of new individuals truly decoded after the pre-screening.
+    unsigned num_surrogate_decodes {0};
+
+    /// Number of new individuals that got only a surrogate estimate.
+    unsigned num_surrogate_estimates {0};
+
+    /**
+     * Number of individuals with surrogate estimates that reached the elite
+     * set, and therefore were decoded.
+     */
+    unsigned num_surrogate_promotions {0};
+    //@}
+
+    /** \name Multi-fidelity counters (see BRKGA_MP_IPR::setMultiFidelity()) */
+    //@{
+    /**
+     * Number of individuals decoded at low fidelity that reached the elite
+     * set, and therefore were re-decoded at high fidelity.
+     */
+    unsigned num_high_fidelity_decodes {0};
+    //@}
+
+    /** \name Bounded decoding counters (see DecodeContext::cutoff()) */
+    //@{
+    /// Number of decodings stopped early by the decoder with a bound.
+    unsigned num_bounded_decodes {0};
+    //@}
+
+    /// Default constructor.
+    AlgorithmStatus() = default;
+
+    /// Destructor.
+    ~AlgorithmStatus() __attribute__((noinline)) = default;
+};
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Output streaming operator for AlgorithmStatus.
+ *
+ * \param output the output stream.
+ * \param status the algorithm status.
+ * \return the output stream.
+ *
+ * \todo Clang fails printing chrono times. When they fix it, please, revise
+ *       this function.
+ */
+INLINE
+std::ostream& operator<<(std::ostream& output, const AlgorithmStatus& status) {
+    output
+    << "\nbest_fitness: " << status.best_fitness
+    << "\ncurrent_iteration: " << status.current_iteration
+    << "\nlast_update_iteration: " << status.last_update_iteration
+    << "\ncurrent_time: " << status.current_time
+    << "\nlast_update_time: " << status.last_update_time
+    << "\nlargest_iteration_offset: " << status.largest_iteration_offset
+    << "\nstalled_iterations: " << status.stalled_iterations
+    << "\npath_relink_time: " << status.path_relink_time
+    << "\nnum_path_relink_calls: " << status.num_path_relink_calls
+    << "\nnum_homogenities: " << status.num_homogenities
+    << "\nnum_best_improvements: " << status.num_best_improvements
+    << "\nnum_elite_improvements: " << status.num_elite_improvements
+    << "\nnum_path_relink_saved_decodes: "
+    << status.num_path_relink_saved_decodes
+    << "\nnum_path_relink_skipped_pairs: "
+    << status.num_path_relink_skipped_pairs
+    << "\nnum_exchanges: " << status.num_exchanges
+    << "\nnum_shakes: " << status.num_shakes
+    << "\nnum_resets: " << status.num_resets
+    << "\nnum_surrogate_decodes: " << status.num_surrogate_decodes
+    << "\nnum_surrogate_estimates: " << status.num_surrogate_estimates
+    << "\nnum_surrogate_promotions: " << status.num_surrogate_promotions
+    << "\nnum_high_fidelity_decodes: " << status.num_high_fidelity_decodes
+    << "\nnum_bounded_decodes: " << status.num_bounded_decodes;
+    return output;
+}
+///@}algorithm_status
+
+//----------------------------------------------------------------------------//
+// Decode context class.
+//----------------------------------------------------------------------------//
+
+/**
+ * \defgroup decode_context Decode context
+ */
+///@{
+
+/**
+ * \brief Fidelity requested to a context-aware decoder (see
+ * BRKGA_MP_IPR::setMultiFidelity()).
+ */
+enum class DecodeFidelity {
+    /// Fast, approximate decoding (e.g., fewer local search iterations).
+    LOW,
+
+    /// Exact decoding.
+    HIGH
+};
+
+/**
+ * \brief Additional information handed to context-aware decoders.
+ *
+ * Besides the regular `decode(Chromosome&, bool)`, a decoder may implement
+ * \code{.cpp}
+ *      fitness_t decode(Chromosome& chromosome, bool rewrite,
+ *                       DecodeContext& context);
+ * \endcode
+ * In such a case, BRKGA_MP_IPR calls this version everywhere it would call
+ * the regular one (see ContextAwareDecoder).
+ *
+ * Most random-key decoders start sorting the keys of the chromosome to build
+ * a permutation. The context provides such permutation through #keyOrder(),
+ * and the framework keeps it along with the chromosome in the population.
+ * Since an offspring inherits most of its keys from its top-ranked parent,
+ * its permutation is rebuilt from the permutation of such parent and the
+ * (few) positions whose keys came from other parents. This rebuild takes
+ * near-linear time instead of sorting all the keys again, and pays off on
+ * long chromosomes: for short ones, the sorting is negligible against the
+ * evolution and the decoding themselves. When most keys came from other
+ * parents (which depends on the bias function and the number of parents),
+ * the permutation is computed from scratch using argsort().
+ *
+ * Decoders that build the cost incrementally may also stop early: when
+ * #hasCutoff() is true, any fitness not better than #cutoff() is irrelevant
+ * for the current stage (the evolution or path relinking). Once the partial
+ * cost reaches the cutoff, the decoder may return it and call
+ * #reportBound(). The framework ranks such bounded individuals after all
+ * exactly decoded ones, so they never enter the elite set nor are chosen as
+ * best solutions.
+ *
+ * Finally, the decoder may attach the decoded solution (a route, schedule,
+ * etc.) to the chromosome through #setPayload(). The framework keeps the
+ * payloads of the elite individuals, moving them along with the chromosomes,
+ * so that the best solution can be fetched without decoding it again (see
+ * BRKGA_MP_IPR::getBestPayload() and AlgorithmStatus::best_payload).
+ *
+ * \warning If the decoder rewrites the chromosome keys after calling
+ *      #keyOrder(), it must call #invalidateKeyOrder(). Otherwise, the
+ *      framework keeps a permutation that does not match the keys.
+ */
+class DecodeContext {
+public:
+    /** \name Default constructors and destructor */
+    ///@{
+    /// Default constructor.
+    DecodeContext() = default;
+
+    /// Copy constructor.
+    DecodeContext(const DecodeContext&) = default;
+
+    /// Assignment operator.
+    DecodeContext& operator=(const DecodeContext&) = default;
+
+    /// Destructor.
+    ~DecodeContext() = default;
+    ///@}
+
+    /** \name Key ordering */
+    ///@{
+    /**
+     * \brief Returns the permutation that sorts the keys of the chromosome
+     *        being decoded.
+     *
+     * The result is exactly the one from argsort(), i.e., the indices sorted
+     * by key, and ties broken by the smallest index.
+     * The permutation is computed once and cached: subsequent calls are free.
+     */
+    const std::vector<unsigned>& keyOrder() {
+        if(*order_valid != 0)
+            return *order;
+
+        const auto size = chromosome->size();
+        order->resize(size);
+
+        if(parent_order != nullptr && parent_order->size() == size &&
+           2 * foreign_positions->size() < size)
+            rebuildFromParent();
+        else
+            argsort(*chromosome, *order, workspace);
+
+        *order_valid = 1;
+        return *order;
+    }
+
+    /**
+     * \brief Discards the cached permutation of keys.
+     *
+     * Must be called if the decoder rewrites the chromosome keys after
+     * calling #keyOrder().
+     */
+    void invalidateKeyOrder() {
+        *order_valid = 0;
+        parent_order = nullptr;
+        foreign_positions = nullptr;
+    }
+    ///@}
+
+    /** \name Fidelity */
+    ///@{
+    /**
+     * \brief Returns the fidelity requested for this decoding.
+     *
+     * It is always DecodeFidelity::HIGH unless multi-fidelity decoding is
+     * enabled (see BRKGA_MP_IPR::setMultiFidelity()).
+     */
+    DecodeFidelity fidelity() const { return requested_fidelity; }
+    ///@}
+
+    /** \name Bounded decoding */
+    ///@{
+    /// Indicates whether there is a cutoff for this decoding.
+    bool hasCutoff() const { return cutoff_set; }
+
+    /**
+     * \brief Returns the fitness a chromosome must beat to matter in the
+     * current stage. Only meaningful if #hasCutoff() is true.
+     */
+    fitness_t cutoff() const { return cutoff_value; }
 
-        std::stringstream line_stream(line);
-        line_stream >> token >> data;
+    /**
+     * \brief Flags the returned fitness as a bound, i.e., a value no better
+     * than the true fitness (a lower bound when minimizing, an upper bound
+     * when maximizing) and no better than #cutoff().
+     *
+     * Ignored if #hasCutoff() is false.
+     */
+    void reportBound() { bound_reported = true; }
+    ///@}
 
-        std::transform(token.begin(), token.end(), token.begin(), tolower);
+    /** \name Intra-decode parallelism */
+    ///@{
+    /**
+     * \brief Returns the number of threads this decoding may use internally.
+     *
+     * It is the share of the budget given by
+     * BRKGA_MP_IPR::setDecodeThreadBudget() among the decodings running at
+     * the moment this one started, and 1 if no budget was set. Therefore,
+     * single decodings (e.g., after path relinking) get the whole budget.
+     */
+    unsigned numThreads() const { return num_threads; }
+    ///@}
 
-        if(auto it_token = token_map.find(token); it_token != token_map.end()) {
-            if(it_token->second.supplied) {
-                std::stringstream error_msg;
-                error_msg
-                << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
-                << "Duplicate attribute on config line " << line_count
-                << ": '" << token << "' already read";
-                throw std::fstream::failure(error_msg.str());
-            }
+    /** \name Solution payload */
+    ///@{
+    /**
+     * \brief Attaches the decoded solution to the chromosome.
+     * \param value any copyable value, retrieved with `std::any_cast`.
+     */
+    template <class T>
+    void setPayload(T&& value) {
+        *payload = std::make_shared<const std::any>(std::forward<T>(value));
+    }
+    ///@}
 
-            it_token->second.set();
+protected:
+    /** \name Framework interface */
+    ///@{
+    /**
+     * \brief Sets the chromosome to be decoded.
+     * \param chr the chromosome.
+     * \param chr_order where the permutation is cached. If null, a local
+     *        buffer is used.
+     * \param chr_order_valid indicates whether `chr_order` is up-to-date.
+     */
+    void setChromosome(const Chromosome& chr,
+                       std::vector<unsigned>* chr_order = nullptr,
+                       std::uint8_t* chr_order_valid = nullptr) {
+        chromosome = &chr;
+        cutoff_set = false;
+        bound_reported = false;
+        fitness_flag = nullptr;
+        payload = &local_payload;
+        local_payload.reset();
+        if(chr_order != nullptr) {
+            order = chr_order;
+            order_valid = chr_order_valid;
         }
         else {
-            std::stringstream error_msg;
-            error_msg
-            << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
-            << "Invalid token on config line " << line_count
-            << ": '" << token << "'";
-            throw std::fstream::failure(error_msg.str());
+            order = &local_order;
+            order_valid = &local_order_valid;
+            local_order_valid = 0;
         }
+        parent_order = nullptr;
+        foreign_positions = nullptr;
     }
 
-    // Check requeriments.
-    for(const auto& param : token_map) {
-        if(!param.second.supplied) {
-            if(param.second.required) {
-                std::stringstream error_msg;
-                error_msg
-                << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
-                << "Parameter '" << param.first
-                << "' is required but it was not supplied in the config file";
-                throw std::fstream::failure(error_msg.str());
-            }
-            else {
-                std::stringstream error_msg;
-                error_msg
-                << "WARNING: parameter '" << param.first
-                << "' was not supplied in the config file. Using default value.";
-                logger << error_msg.str() << "\n";
-            }
-        }
+    /**
+     * \brief Sets the hint to rebuild the permutation of an offspring.
+     * \param dominant_order the permutation of the dominant parent.
+     * \param positions the positions, in increasing order, whose keys
+     *        did not come from the dominant parent.
+     */
+    void setParentHint(const std::vector<unsigned>& dominant_order,
+                       const std::vector<unsigned>& positions) {
+        parent_order = &dominant_order;
+        foreign_positions = &positions;
     }
 
-    // Check distance function for IPR.
-    switch(brkga_params.pr_distance_function_type) {
-    case PathRelinking::DistanceFunctionType::HAMMING:
-        brkga_params.pr_distance_function =
-            std::shared_ptr<DistanceFunctionBase> {new HammingDistance};
-        break;
+    /**
+     * \brief Rebuilds the permutation merging the permutation of the
+     *        dominant parent (without the foreign positions) with the sorted
+     *        foreign positions.
+     */
+    void rebuildFromParent() {
+        const auto& keys = *chromosome;
+        const auto& foreign = *foreign_positions;
+
+        // Sort the foreign positions by their keys. Since the positions are
+        // in increasing order, ties are still broken by the smallest index.
+        foreign_keys.resize(foreign.size());
+        for(std::size_t i = 0; i < foreign.size(); ++i)
+            foreign_keys[i] = keys[foreign[i]];
+
+        foreign_order.resize(foreign.size());
+        argsort(foreign_keys.data(), foreign_keys.size(),
+                foreign_order.data(), workspace);
+        for(auto& idx : foreign_order)
+            idx = foreign[idx];
+
+        is_foreign.resize(keys.size(), 0);
+        for(const auto idx : foreign)
+            is_foreign[idx] = 1;
+
+        const auto less = [&keys](const unsigned a, const unsigned b) {
+            return keys[a] < keys[b] || (!(keys[b] < keys[a]) && a < b);
+        };
 
-    case PathRelinking::DistanceFunctionType::KENDALLTAU:
-        brkga_params.pr_distance_function =
-            std::shared_ptr<DistanceFunctionBase> {new KendallTauDistance};
-        break;
+        // The remaining keys are the same of the parent, therefore, they
+        // are already sorted. Just merge both sequences.
+        auto out = order->begin();
+        auto it_foreign = foreign_order.cbegin();
+        for(const auto idx : *parent_order) {
+            if(is_foreign[idx] != 0)
+                continue;
+            while(it_foreign != foreign_order.cend() && less(*it_foreign, idx))
+                *out++ = *it_foreign++;
+            *out++ = idx;
+        }
+        std::copy(it_foreign, foreign_order.cend(), out);
 
-    default:
-        std::stringstream error_msg;
-        error_msg
-        << "WARNING: distance function set to '"
-        << brkga_params.pr_distance_function_type << "'. "
-        << "The user must supply his/her own distance functor if using IPR.";
-        logger << error_msg.str() << "\n";
-        break;
+        for(const auto idx : foreign)
+            is_foreign[idx] = 0;
     }
+    ///@}
 
-    // Check shaking procedure.
-    if(brkga_params.shaking_type == ShakingType::CUSTOM) {
-        logger << "WARNING: shaking distance set to 'CUSTOM'. "
-                   "The user must supply his/her own if using shaking.";
-    }
+protected:
+    /** \name Data members */
+    ///@{
+    /// The chromosome being decoded.
+    const Chromosome* chromosome {nullptr};
 
-    return std::make_pair(std::move(brkga_params), std::move(control_params));
-}
+    /// Where the permutation is kept.
+    std::vector<unsigned>* order {nullptr};
 
-//----------------------------------------------------------------------------//
+    /// Indicates whether `order` is up-to-date.
+    std::uint8_t* order_valid {nullptr};
 
-/**
- * \brief Reads the parameters from a configuration file.
- *
- * \param filename the configuration file.
- * \param logger a output stream to log some information such as missing
- *               no-required parameters. It does not log errors.
- * \returns a tuple containing the BRKGA and external control parameters.
- * \throws std::fstream::failure in case of errors in the file.
- */
-INLINE std::pair<BrkgaParams, ControlParams>
-readConfiguration(const std::string& filename,
-                  std::ostream& logger = std::cout) {
+    /// Permutation of the dominant parent, if any.
+    const std::vector<unsigned>* parent_order {nullptr};
 
-    std::ifstream input(filename, std::ios::in);
-    if(!input) {
-        std::stringstream error_msg;
-        error_msg << "File '" << filename << "' cannot be opened!";
-        throw std::fstream::failure(error_msg.str());
-    }
-    return readConfiguration(input, logger);
-}
+    /// Positions whose keys did not come from the dominant parent.
+    const std::vector<unsigned>* foreign_positions {nullptr};
 
-//----------------------------------------------------------------------------//
-// Writing the parameters into file
-//----------------------------------------------------------------------------//
+    /// Permutation used when the chromosome has no cache on the population.
+    std::vector<unsigned> local_order {};
+
+    /// Indicates whether `local_order` is up-to-date.
+    std::uint8_t local_order_valid {0};
+
+    /// Scratch memory for argsort().
+    ArgSortWorkspace workspace {};
+
+    /// Scratch memory for the keys of the foreign positions.
+    std::vector<double> foreign_keys {};
+
+    /// Scratch memory for the sorted foreign positions.
+    std::vector<unsigned> foreign_order {};
+
+    /// Scratch memory to mark the foreign positions.
+    std::vector<std::uint8_t> is_foreign {};
+
+    /// Fidelity requested for the current decoding.
+    DecodeFidelity requested_fidelity {DecodeFidelity::HIGH};
+
+    /// Indicates whether `cutoff_value` holds a cutoff.
+    bool cutoff_set {false};
+
+    /// Cutoff for the current decoding.
+    fitness_t cutoff_value {};
+
+    /// Indicates whether the decoder returned a bound.
+    bool bound_reported {false};
+
+    /// Flag of the individual's fitness in the population, if any.
+    std::uint8_t* fitness_flag {nullptr};
+
+    /// Number of threads the current decoding may use.
+    unsigned num_threads {1};
+
+    /// Where the payload is kept.
+    std::shared_ptr<const std::any>* payload {&local_payload};
+
+    /// Payload used when the chromosome does not belong to a population.
+    std::shared_ptr<const std::any> local_payload {};
+    ///@}
+
+    template <class Decoder>
+    friend class BRKGA_MP_IPR;
+};
 
 /**
- * \brief Output stream operator for BrkgaParams.
+ * \brief Concept satisfied by decoders that implement the context-aware
+ * asynchronous decoding method
+ * `std::future<fitness_t> decodeAsync(Chromosome&, bool, DecodeContext&)`.
  *
- * \param os the output stream.
- * \param brkga_params the parameters.
- * \return the output stream.
+ * The context is not used by any other decoding until the future is ready.
  */
-INLINE std::ostream&
-operator<<(std::ostream& os, const BrkgaParams& brkga_params) {
-    os
-    << "population_size " << brkga_params.population_size << "\n"
-    << std::setiosflags(std::ios::fixed) << std::setprecision(2)
-    << "elite_percentage " << brkga_params.elite_percentage << "\n"
-    << "mutants_percentage " << brkga_params.mutants_percentage << "\n"
-    << "num_elite_parents " << brkga_params.num_elite_parents << "\n"
-    << "total_parents " << brkga_params.total_parents << "\n"
-    << "bias_type " << brkga_params.bias_type << "\n"
-    << "num_independent_populations "
-    << brkga_params.num_independent_populations << "\n"
-    << "pr_number_pairs " << brkga_params.pr_number_pairs << "\n"
-    << "pr_minimum_distance " << brkga_params.pr_minimum_distance << "\n"
-    << "pr_type " << brkga_params.pr_type << "\n"
-    << "pr_selection " << brkga_params.pr_selection << "\n"
-    << "pr_distance_function_type " << brkga_params.pr_distance_function_type << "\n"
-    << "alpha_block_size " << brkga_params.alpha_block_size << "\n"
-    << "pr_percentage " << brkga_params.pr_percentage << "\n"
-    << "num_exchange_individuals "
-    << brkga_params.num_exchange_individuals << "\n"
-    << "shaking_type " << brkga_params.shaking_type << "\n"
-    << "shaking_intensity_lower_bound " << brkga_params.shaking_intensity_lower_bound << "\n"
-    << "shaking_intensity_upper_bound " << brkga_params.shaking_intensity_upper_bound << "\n";
-    return os;
-}
+template <class Decoder>
+concept ContextAwareAsyncDecoder =
+    requires(Decoder& decoder, Chromosome& chromosome, DecodeContext& context) {
+        { decoder.decodeAsync(chromosome, true, context) } ->
+            std::same_as<std::future<fitness_t>>;
+    };
 
 /**
- * \brief Output stream operator for ControlParams.
- *
- * \param os the output stream.
- * \param control_params the parameters.
- * \return the output stream.
+ * \brief Concept satisfied by decoders that implement the context-aware
+ * decoding method `decode(Chromosome&, bool, DecodeContext&)`, or its
+ * asynchronous version (see ContextAwareAsyncDecoder).
  */
-INLINE std::ostream&
-operator<<(std::ostream& os, const ControlParams& control_params) {
-    os
-    << "maximum_running_time " << control_params.maximum_running_time << "\n"
-    << "exchange_interval " << control_params.exchange_interval << "\n"
-    << "shake_interval " << control_params.shake_interval << "\n"
-    << "ipr_interval " << control_params.ipr_interval << "\n"
-    << "reset_interval " << control_params.reset_interval << "\n"
-    << "stall_offset " << control_params.stall_offset;
-    return os;
-}
+template <class Decoder>
+concept ContextAwareDecoder =
+    ContextAwareAsyncDecoder<Decoder> ||
+    requires(Decoder& decoder, Chromosome& chromosome, DecodeContext& context) {
+        { decoder.decode(chromosome, true, context) } ->
+            std::convertible_to<fitness_t>;
+    };
 
 /**
- * \brief Writes the parameters into a output stream.
- *
- * \note All floating point parameters are written with two point precision.
- *
- * \param output the output stream.
- * \param brkga_params the BRKGA parameters.
- * \param control_params the external control parameters. Default is an empty
- *        object.
- * \throws std::fstream::failure in case of errors in the file.
- *
- * \todo This method can beneficiate from introspection tools.
- *       We would like achieve a code similar to the
- *       [Julia counterpart](<https://github.com/ceandrade/brkga_mp_ipr_julia>).
+ * \brief Concept satisfied by decoders that implement the asynchronous
+ * decoding method `std::future<fitness_t> decodeAsync(Chromosome&, bool)`,
+ * or its context-aware version (see ContextAwareAsyncDecoder).
  */
-INLINE void writeConfiguration(std::ostream& output,
-        const BrkgaParams& brkga_params,
-        const ControlParams& control_params = ControlParams{}) {
-    output << brkga_params << control_params << "\n";
-}
+template <class Decoder>
+concept AsyncDecoder =
+    ContextAwareAsyncDecoder<Decoder> ||
+    requires(Decoder& decoder, Chromosome& chromosome) {
+        { decoder.decodeAsync(chromosome, true) } ->
+            std::same_as<std::future<fitness_t>>;
+    };
+///@} decode_context
 
+//----------------------------------------------------------------------------//
+// Ask/tell classes.
 //----------------------------------------------------------------------------//
 
 /**
- * \brief Writes the parameters into a configuration file.
- *
- * \note All floating point parameters are written with two point precision.
- *
- * \param filename the configuration file.
- * \param brkga_params the BRKGA parameters.
- * \param control_params the external control parameters.
- *        Default is an empty object.
- * \throws std::fstream::failure in case of errors in the file.
+ * \defgroup ask_tell Ask/tell interface
  */
-INLINE void writeConfiguration(const std::string& filename,
-        const BrkgaParams& brkga_params,
-        const ControlParams& control_params = ControlParams{}) {
+///@{
 
-    std::ofstream output(filename, std::ios::out);
-    if(!output) {
-        std::stringstream error_msg;
-        error_msg << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
-                  << "File '" << filename << "' cannot be opened!";
-        throw std::fstream::failure(error_msg.str());
-    }
+/**
+ * \brief A batch of chromosomes waiting for their fitness.
+ *
+ * Returned by BRKGA_MP_IPR::ask(). The views point to the chromosomes kept
+ * by the algorithm, and are valid until BRKGA_MP_IPR::tell() is called.
+ */
+class EvaluationBatch {
+public:
+    /// Returns the number of chromosomes in the batch.
+    std::size_t size() const { return chromosomes.size(); }
 
-    writeConfiguration(output, brkga_params, control_params);
-    output.close();
-}
-///@} brkga_control_params
+    /// Returns true if the batch is empty, i.e., the work is done.
+    bool empty() const { return chromosomes.empty(); }
 
-//----------------------------------------------------------------------------//
-// Algorithm status
-//----------------------------------------------------------------------------//
+public:
+    /// Views of the chromosomes to be evaluated.
+    std::vector<std::span<double>> chromosomes {};
 
-/**
- * \defgroup algorithm_status Algorithm status utilities
- */
-///@{
+    /**
+     * \brief Indicates whether the evaluator may rewrite the keys (e.g.,
+     * after a local search), as `rewrite` in `Decoder::decode()`.
+     */
+    bool rewrite {false};
+};
 
 /**
- * \brief Defines the current status of the algorithm for a given
- * BRKGA_MP_IPR::run() call.
+ * \brief Hands the decodings of a BRKGA_MP_IPR to the caller of
+ * BRKGA_MP_IPR::ask() and BRKGA_MP_IPR::tell().
  *
- * \note We use `std::chrono::duration<double>` instead `std::chrono::seconds`
- *      for keep better precision.
+ * The work given to BRKGA_MP_IPR::beginAskTell() runs in a driver thread.
+ * Each time the algorithm needs to decode a batch of chromosomes, the driver
+ * publishes the batch and sleeps until the fitness values are told.
+ * This class is used internally by BRKGA_MP_IPR only.
  */
-class AlgorithmStatus {
+class AskTellSession {
 public:
-    /** \name Best current solution */
-    //@{
-    /// Current best fitness value.
-    fitness_t best_fitness {};
+    /// Builds an idle session. The driver starts in start().
+    AskTellSession() = default;
+
+    /**
+     * \brief Starts the driver thread running `work`.
+     *
+     * The work may check whether the session is open. So, the session must
+     * be reachable by the work (e.g., stored in its owner) before this call.
+     */
+    void start(std::function<void()> work) {
+        driver = std::thread([this, work = std::move(work)] {
+            try {
+                work();
+            }
+            catch(...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            state = State::DONE;
+            signal.notify_all();
+        });
+    }
 
-    /// A pointer to the current best chromosome.
-    Chromosome best_chromosome {};
-    //@}
+    /// Cancels a pending batch, if any, and waits for the driver to finish.
+    ~AskTellSession() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cancelled = true;
+            signal.notify_all();
+        }
+        if(driver.joinable())
+            driver.join();
+    }
 
-    /** \name General iteration counters */
-    //@{
-    /// The current algorithm iteration / generation.
-    unsigned current_iteration {0};
+    AskTellSession(const AskTellSession&) = delete;
+    AskTellSession& operator=(const AskTellSession&) = delete;
 
-    /// The iteration of the last update.
-    unsigned last_update_iteration {0};
+    /**
+     * \brief Waits for the next batch (caller side).
+     * \returns the batch, or an empty batch if the work is done.
+     */
+    EvaluationBatch ask() {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [this] { return state != State::RUNNING; });
+
+        EvaluationBatch batch;
+        if(state == State::WAITING_FITNESS) {
+            batch.rewrite = rewrite;
+            batch.chromosomes.reserve(chromosomes.size());
+            for(auto chromosome : chromosomes)
+                batch.chromosomes.emplace_back(chromosome->data(),
+                                               chromosome->size());
+        }
+        return batch;
+    }
 
-    /// The time of the last update (in seconds).
-    std::chrono::duration<double> current_time {0.0};
+    /// Commits the fitness values of the current batch (caller side).
+    void tell(const std::vector<fitness_t>& values) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(state != State::WAITING_FITNESS) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "There is no batch waiting for fitness values.";
+            throw std::runtime_error(ss.str());
+        }
 
-    /// The time of the last update (in seconds).
-    std::chrono::duration<double> last_update_time {0.0};
+        if(values.size() != chromosomes.size()) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "Got " << values.size() << " fitness values for a batch of "
+               << chromosomes.size() << " chromosomes.";
+            throw std::range_error(ss.str());
+        }
 
-    /// The largest number of iterations between two updates.
-    unsigned largest_iteration_offset {0};
+        fitness = values;
+        state = State::RUNNING;
+        signal.notify_all();
+    }
 
-    /// Last number of iterations without improvement in the best solution.
-    unsigned stalled_iterations {0};
-    //@}
+    /**
+     * \brief Publishes the batch in #chromosomes and waits for the fitness
+     * values, left in #fitness (driver side).
+     *
+     * \throws std::runtime_error if the session is cancelled meanwhile.
+     */
+    void publish(const bool _rewrite) {
+        std::unique_lock<std::mutex> lock(mutex);
+        rewrite = _rewrite;
+        state = State::WAITING_FITNESS;
+        signal.notify_all();
+        signal.wait(lock, [this] {
+            return state == State::RUNNING || cancelled;
+        });
+
+        if(cancelled) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "The ask/tell session was cancelled.";
+            throw std::runtime_error(ss.str());
+        }
+    }
 
-    /** \name Path relinking counters */
-    //@{
-    /// Total time spent on path relinking so far (in seconds).
-    std::chrono::duration<double> path_relink_time {0.0};
+    /// Waits for the driver and rethrows its exception, if any.
+    void finish() {
+        driver.join();
+        if(error)
+            std::rethrow_exception(error);
+    }
 
-    /// Number of call to path relinking.
-    unsigned num_path_relink_calls {0};
+public:
+    /// Stages of the session.
+    enum class State {
+        /// The driver is running the algorithm.
+        RUNNING,
 
-    /** Number of homogenities, i.e., number of times that the populations are
-     * too homogenious and the path reliking could not be performed.
-     */
-    unsigned num_homogenities {0};
+        /// The driver waits for the fitness of the published batch.
+        WAITING_FITNESS,
 
-    /// Number of improvements in the best solution by the path reliking.
-    unsigned num_best_improvements {0};
+        /// The work is done.
+        DONE
+    };
 
-    /** Number of improvements in elite individuals, but not the best one,
-     * by path reliking.
-     */
-    unsigned num_elite_improvements {0};
-    //@}
+    /** \name Batch data */
+    ///@{
+    /// Chromosomes of the current batch.
+    std::vector<Chromosome*> chromosomes {};
 
-    /** \name Exchange, reset, and shake counters */
-    //@{
-    /** Number of exchange between populations performed
-     * (not number of individuals).
-     */
-    unsigned num_exchanges {0};
+    /// Indices of these chromosomes within the decoding batch.
+    std::vector<std::size_t> indices {};
 
-    /// Number of shakes performed.
-    unsigned num_shakes {0};
+    /// Their fitness values.
+    std::vector<fitness_t> fitness {};
 
-    /// Number of population resets performed.
-    unsigned num_resets {0};
-    //@}
+    /// Indicates whether the keys may be rewritten.
+    bool rewrite {false};
+    ///@}
 
-    /// Default constructor.
-    AlgorithmStatus() = default;
+protected:
+    /** \name Synchronization */
+    ///@{
+    /// Current stage.
+    State state {State::RUNNING};
 
-    /// Destructor.
-    ~AlgorithmStatus() __attribute__((noinline)) = default;
-};
+    /// Set when the session is destroyed before the work is done.
+    bool cancelled {false};
 
-//----------------------------------------------------------------------------//
+    /// Exception thrown by the work, if any.
+    std::exception_ptr error {};
 
-/**
- * \brief Output streaming operator for AlgorithmStatus.
- *
- * \param output the output stream.
- * \param status the algorithm status.
- * \return the output stream.
- *
- * \todo Clang fails printing chrono times. When they fix it, please, revise
- *       this function.
- */
-INLINE
-std::ostream& operator<<(std::ostream& output, const AlgorithmStatus& status) {
-    output
-    << "\nbest_fitness: " << status.best_fitness
-    << "\ncurrent_iteration: " << status.current_iteration
-    << "\nlast_update_iteration: " << status.last_update_iteration
-    << "\ncurrent_time: " << status.current_time
-    << "\nlast_update_time: " << status.last_update_time
-    << "\nlargest_iteration_offset: " << status.largest_iteration_offset
-    << "\nstalled_iterations: " << status.stalled_iterations
-    << "\npath_relink_time: " << status.path_relink_time
-    << "\nnum_path_relink_calls: " << status.num_path_relink_calls
-    << "\nnum_homogenities: " << status.num_homogenities
-    << "\nnum_best_improvements: " << status.num_best_improvements
-    << "\nnum_elite_improvements: " << status.num_elite_improvements
-    << "\nnum_exchanges: " << status.num_exchanges
-    << "\nnum_shakes: " << status.num_shakes
-    << "\nnum_resets: " << status.num_resets;
-    return output;
-}
-///@}algorithm_status
+    /// Guards all data above.
+    std::mutex mutex {};
+
+    /// Signals every change of stage.
+    std::condition_variable signal {};
+
+    /// Runs the work.
+    std::thread driver {};
+    ///@}
+};
+///@} ask_tell
 
 //----------------------------------------------------------------------------//
 // Population class.
@@ -1514,6 +3460,40 @@ public:
 
     /// Fitness of each chromosome.
     std::vector<std::pair<fitness_t, unsigned>> fitness;
+
+    /**
+     * \brief Permutation that sorts the keys of each chromosome
+     * (see DecodeContext::keyOrder()). Only filled for context-aware decoders.
+     */
+    std::vector<std::vector<unsigned>> key_orders;
+
+    /// Indicates whether `key_orders[i]` matches the keys of chromosome `i`.
+    std::vector<std::uint8_t> key_order_valid;
+
+    /**
+     * \brief Indicates whether the fitness of chromosome `i` is approximate,
+     * and why: #EXACT_FITNESS, #SURROGATE_FITNESS, #LOW_FIDELITY_FITNESS, or
+     * #BOUNDED_FITNESS.
+     */
+    std::vector<std::uint8_t> approximate_fitness;
+
+    /// The fitness was decoded at high fidelity.
+    static constexpr std::uint8_t EXACT_FITNESS {0};
+
+    /// The fitness is a surrogate estimate.
+    static constexpr std::uint8_t SURROGATE_FITNESS {1};
+
+    /// The fitness was decoded at low fidelity.
+    static constexpr std::uint8_t LOW_FIDELITY_FITNESS {2};
+
+    /// The fitness is a bound returned by a decoding stopped early.
+    static constexpr std::uint8_t BOUNDED_FITNESS {3};
+
+    /**
+     * \brief Solution payload attached by the decoder to chromosome `i`, if
+     * any. Only kept for the elite individuals.
+     */
+    std::vector<std::shared_ptr<const std::any>> payloads;
     ///@}
 
     /** \name Default constructors and destructor */
@@ -1526,7 +3506,11 @@ public:
      */
     Population(const unsigned chr_size, const unsigned pop_size):
         chromosomes(pop_size, Chromosome(chr_size, 0.0)),
-        fitness(pop_size)
+        fitness(pop_size),
+        key_orders(pop_size),
+        key_order_valid(pop_size, 0),
+        approximate_fitness(pop_size, EXACT_FITNESS),
+        payloads(pop_size)
     {
         if(pop_size == 0)
             throw std::range_error("Population size cannot be zero.");
@@ -1620,6 +3604,10 @@ public:
     ///@{
     /**
      * \brief Sorts `fitness` by its first parameter according to the sense.
+     *
+     * Bounded fitness values cannot be compared to exact ones, so such
+     * individuals are placed after all the others.
+     *
      * \param sense Optimization sense.
      */
     void sortFitness(const Sense sense) {
@@ -1627,6 +3615,14 @@ public:
             std::sort(fitness.begin(), fitness.end(), std::greater<>());
         else
             std::sort(fitness.begin(), fitness.end(), std::less<>());
+
+        if(std::find(approximate_fitness.begin(), approximate_fitness.end(),
+                     BOUNDED_FITNESS) != approximate_fitness.end()) {
+            std::stable_partition(fitness.begin(), fitness.end(),
+                [this](const std::pair<fitness_t, unsigned>& item) {
+                    return approximate_fitness[item.second] != BOUNDED_FITNESS;
+                });
+        }
     }
 
     /**
@@ -1689,7 +3685,59 @@ public:
  * decoding several chromosomes in parallel, the user must guarantee that
  * `Decoder::decode(...)` is thread-safe. Therefore, we do recommend to have
  * the writable variables per thread. Please, see the example that follows this
- * code.
+ * code. Decoders that cannot be made thread-safe (for instance, those wrapping
+ * non-reentrant libraries) can still be run in parallel through
+ * ProcessDecoderPool (`process_decoder_pool.hpp`), which decodes in separate
+ * worker processes.
+ *
+ * Optionally, the decoder may implement the context-aware method
+ * \code{.cpp}
+ *      fitness_t decode(Chromosome& chromosome, bool rewrite,
+ *                       DecodeContext& context);
+ * \endcode
+ *
+ * which is called instead of the regular one. Through the DecodeContext,
+ * the decoder obtains the permutation that sorts the chromosome keys, kept by
+ * the framework along with the population and rebuilt cheaply for offspring.
+ *
+ * Decoders that only hand the evaluation to an external process or service
+ * (and mostly wait on I/O) may implement, instead, the asynchronous method
+ * \code{.cpp}
+ *      std::future<fitness_t> decodeAsync(Chromosome& chromosome,
+ *                                         bool rewrite);
+ * \endcode
+ *
+ * In this case, the framework launches up to
+ * #setMaxInFlightDecodes() decodings at once from the calling thread, and
+ * collects the results as they become ready, without holding one thread per
+ * evaluation. The chromosome is kept alive and untouched until its future is
+ * ready. When present, `decodeAsync()` takes precedence over the other
+ * decoding methods. Asynchronous decoders that need the DecodeContext must
+ * implement the context-aware version
+ * \code{.cpp}
+ *      std::future<fitness_t> decodeAsync(Chromosome& chromosome,
+ *                                         bool rewrite,
+ *                                         DecodeContext& context);
+ * \endcode
+ *
+ * The context is kept for such decoding until its future is ready. A decoder
+ * with the context-aware `decode()` and the regular `decodeAsync()` does not
+ * compile, since the asynchronous decodings would lose the context.
+ *
+ * Finally, the evaluation may be driven by the user, instead of the decoder,
+ * through the ask/tell interface (see beginAskTell()). In this case, the
+ * algorithm hands out batches of chromosomes and waits for their fitness.
+ *
+ * When decoding is expensive, a surrogate model (see SurrogateModelBase and
+ * #setSurrogateModel()) can pre-screen the offspring, so that only the most
+ * promising ones are decoded on each generation. The others carry the
+ * surrogate estimate until they reach the elite set, when they are decoded.
+ * Similarly, context-aware decoders with a fast approximate mode may use
+ * multi-fidelity decoding (see #setMultiFidelity() and DecodeFidelity), in
+ * which only the elite candidates are decoded exactly.
+ * Decoders that build the cost incrementally may also stop as soon as the
+ * partial cost shows that the chromosome cannot matter, using the cutoff
+ * given by DecodeContext::cutoff().
  *
  * Implicit Path Relinking {#ipr}
  * ------------------------
@@ -1790,6 +3838,12 @@ public:
  * number of threads is also tied to the memory utilization, and it should be
  * monitored carefully.
  *
+ * Decoders that parallelize internally (e.g., a parallel local search) should
+ * not spawn threads freely, since #max_threads decodings run at once.
+ * Instead, set a global core budget with #setDecodeThreadBudget() and read
+ * the number of workers each decoding may use from
+ * DecodeContext::numThreads().
+ *
  * History {#hist}
  * ========================
  *
@@ -1799,6 +3853,11 @@ public:
  */
 template <class Decoder>
 class BRKGA_MP_IPR {
+    static_assert(!AsyncDecoder<Decoder> || !ContextAwareDecoder<Decoder> ||
+                  ContextAwareAsyncDecoder<Decoder>,
+                  "Context-aware asynchronous decoders must implement "
+                  "decodeAsync(Chromosome&, bool, DecodeContext&)");
+
 public:
     /** \name Constructors and destructor */
     ///@{
@@ -1976,6 +4035,78 @@ public:
         const std::function<bool(const AlgorithmStatus&)>& stopping_criteria
     );
 
+    /**
+     * \brief Sets the maximum number of decodings in flight at once when the
+     * decoder implements the asynchronous method `decodeAsync()`.
+     *
+     * This limit is independent of the number of threads, since an
+     * asynchronous decoding does not hold a thread while waiting for its
+     * result. The default is the number of threads given in the constructor.
+     * It has no effect for synchronous decoders.
+     *
+     * \param max_in_flight the maximum number of pending decodings.
+     * \throws std::range_error if `max_in_flight` is zero.
+     */
+    void setMaxInFlightDecodes(unsigned max_in_flight);
+
+    /**
+     * \brief Sets the total number of threads shared by the concurrent
+     * decodings and their internal parallelism.
+     *
+     * Each decoding of a context-aware decoder is told, through
+     * DecodeContext::numThreads(), the share of the budget it may use:
+     * the budget divided by the number of decodings in flight when it
+     * starts. Therefore, the split adapts to the batch size: a full
+     * population is decoded with #max_threads concurrent decodings, while
+     * the last decodings of a batch, the elite re-decodings, and the
+     * decodings after path relinking get more threads each.
+     *
+     * When the budget is set, nested OpenMP parallelism is enabled, so that
+     * the decoders can use `#pragma omp parallel num_threads(...)`.
+     *
+     * \param budget the total number of threads, usually the number of
+     *        physical cores, or 0 to disable (each decoding gets 1 thread).
+     */
+    void setDecodeThreadBudget(unsigned budget);
+
+    /**
+     * \brief Sets a surrogate model to pre-screen the offspring before
+     * decoding them.
+     *
+     * On each generation, the model estimates the fitness of all offspring
+     * and mutants, and only the `decode_fraction` most promising ones are
+     * decoded. The others keep the estimates as fitness. However, any
+     * individual that reaches the elite set with an estimate is decoded
+     * before the generation ends, so the elite set only holds decoded
+     * fitness. The model is trained with every decoded individual, and
+     * while it is not ready, all offspring are decoded.
+     *
+     * \param model the surrogate model, or `nullptr` to disable pre-screening.
+     * \param decode_fraction the fraction of the non-elite individuals
+     *        decoded on each generation.
+     * \throws std::range_error if `decode_fraction` is not in the interval
+     *         (0, 1].
+     */
+    void setSurrogateModel(std::shared_ptr<SurrogateModelBase> model,
+                           double decode_fraction);
+
+    /**
+     * \brief Enables or disables multi-fidelity decoding.
+     *
+     * When enabled, all chromosomes (initial population, offspring, shaken
+     * individuals, and path relinking candidates) are decoded with
+     * DecodeFidelity::LOW in the decode context. Only those about to enter
+     * the elite set, and the best solution of each path relinking, are
+     * re-decoded with DecodeFidelity::HIGH. Therefore, the elite set, the
+     * best solution, and the solutions reported to the observers always have
+     * high-fidelity fitness.
+     *
+     * \param enable true to enable multi-fidelity decoding.
+     * \throws std::runtime_error if the decoder is not context-aware
+     *         (see ContextAwareDecoder), since it cannot read the fidelity.
+     */
+    void setMultiFidelity(bool enable);
+
     /**
      * \brief Adds a callback function called when the best solution is
      * improved.
@@ -2108,6 +4239,70 @@ public:
     );
     ///@}
 
+    /** \name Ask/tell interface */
+    ///@{
+    /**
+     * \brief Starts an ask/tell session, in which the caller evaluates the
+     * chromosomes instead of the decoder.
+     *
+     * `work` runs in a driver thread, and may call any method of this
+     * object, such as run(), evolve(), pathRelink(), or shake(). Each time
+     * such methods need to decode chromosomes (initial population, offspring
+     * and mutants, shaken and injected individuals, IPR candidates), the
+     * driver publishes the chromosomes as a batch, returned by ask(), and
+     * waits for their fitness values, given by tell(). For instance:
+     * \code{.cpp}
+     * AlgorithmStatus status;
+     * algorithm.beginAskTell([&] {
+     *     status = algorithm.run(control_params, nullptr);
+     * });
+     *
+     * for(auto batch = algorithm.ask(); !batch.empty();
+     *     batch = algorithm.ask()) {
+     *     std::vector<fitness_t> values = my_farm.evaluate(batch.chromosomes);
+     *     algorithm.tell(values);
+     * }
+     * // Here, the work is done and `status` is set.
+     * \endcode
+     *
+     * Several instances can be overlapped by interleaving their ask() and
+     * tell() calls. The regular decoding, used when no session is open,
+     * follows exactly the same batches, but decoding them in place.
+     *
+     * \warning While the session is open, do not call other methods of this
+     *          object outside `work`. If the object is destroyed during a
+     *          session, the pending batch is cancelled and `work` receives a
+     *          `std::runtime_error`.
+     *
+     * \param work the procedure to be run.
+     * \throws std::runtime_error if a session is already open.
+     */
+    void beginAskTell(std::function<void()> work);
+
+    /**
+     * \brief Returns the next batch of chromosomes waiting for fitness.
+     *
+     * Blocks until `work` needs decoding or finishes. In the latter case,
+     * the session is closed and an empty batch is returned.
+     *
+     * \returns the batch, valid until the next call to tell().
+     * \throws std::runtime_error if there is no open session.
+     * \throws any exception thrown by `work`, when it finishes.
+     */
+    EvaluationBatch ask();
+
+    /**
+     * \brief Commits the fitness values of the last batch returned by ask().
+     *
+     * \param fitness_values the fitness of each chromosome, in the same order
+     *        of the batch.
+     * \throws std::runtime_error if there is no batch waiting for fitness.
+     * \throws std::range_error if the number of values differs from the
+     *         batch size.
+     */
+    void tell(const std::vector<fitness_t>& fitness_values);
+    ///@}
+
     /** \name Evolution */
     ///@{
     /**
@@ -2150,6 +4345,11 @@ public:
      * Yet, if such pairs are not found in any case, the algorithm declares
      * failure. This indicates that the populations are very homogeneous.
      *
+     * If BrkgaParams::pr_pair_memory_size is positive, pairs whose path was
+     * walked to the end recently are skipped without being tested. If pairs
+     * were only skipped, the result is
+     * PathRelinking::PathRelinkingResult::NO_IMPROVEMENT.
+     *
      * If the found solution is the best solution found so far, IPR replaces the
      * worst solution by it. Otherwise, IPR computes the distance between the
      * found solution and all other solutions in the elite set, and replaces the
@@ -2330,6 +4530,23 @@ public:
      */
     const Chromosome& getBestChromosome() const;
 
+    /**
+     * \brief Returns the solution payload attached by the decoder to the
+     * chromosome with best fitness among all current populations, or null
+     * if there is none (see DecodeContext::setPayload()).
+     *
+     * Use `std::any_cast` to retrieve the solution, e.g.:
+     * \code{.cpp}
+     * const auto payload = algorithm.getBestPayload();
+     * if(payload)
+     *     const auto& tour = std::any_cast<const Tour&>(*payload);
+     * \endcode
+     *
+     * \warning As #getBestChromosome(), it refers to the current population
+     *      only.
+     */
+    std::shared_ptr<const std::any> getBestPayload() const;
+
     /**
      * \brief Returns the best fitness among all current populations.
      *
@@ -2356,35 +4573,221 @@ public:
     ) const;
 
     /**
-     * \brief Returns the fitness of a chromosome of the given population.
-     * \param population_index the population index.
-     * \param position the chromosome position, ordered by fitness.
-     *        The best chromosome is located in position 0.
-     * \throws std::range_error eitheir if `population_index` is larger
-     *         than number of populations, or `position` is larger than the
-     *         population size.
+     * \brief Returns the fitness of a chromosome of the given population.
+     * \param population_index the population index.
+     * \param position the chromosome position, ordered by fitness.
+     *        The best chromosome is located in position 0.
+     * \throws std::range_error eitheir if `population_index` is larger
+     *         than number of populations, or `position` is larger than the
+     *         population size.
+     */
+    fitness_t getFitness(unsigned population_index, unsigned position) const;
+
+    /**
+     * \brief Indicates whether the fitness of a chromosome is a surrogate
+     * estimate (see #setSurrogateModel()) or a low-fidelity decoding (see
+     * #setMultiFidelity()).
+     * \param population_index the population index.
+     * \param position the chromosome position, ordered by fitness.
+     *        The best chromosome is located in position 0.
+     * \throws std::range_error eitheir if `population_index` is larger
+     *         than number of populations, or `position` is larger than the
+     *         population size.
+     */
+    bool isFitnessApproximate(unsigned population_index,
+                              unsigned position) const;
+    ///@}
+
+    /** \name Parameter getters */
+    ///@{
+    const BrkgaParams& getBrkgaParams() const { return params; }
+
+    Sense getOptimizationSense() const { return optimization_sense; }
+
+    unsigned getChromosomeSize() const { return chromosome_size; }
+
+    unsigned getEliteSize() const { return elite_size; }
+
+    unsigned getNumMutants() const { return num_mutants; }
+
+    bool evolutionaryIsMechanismOn() const { return evolutionary_mechanism_on; }
+
+    unsigned getMaxThreads() const { return max_threads; }
+
+    unsigned getMaxInFlightDecodes() const { return max_in_flight_decodes; }
+
+    unsigned getDecodeThreadBudget() const { return decode_thread_budget; }
+
+    bool isMultiFidelity() const { return multi_fidelity; }
+    ///@}
+
+protected:
+    /** \name Path relinking types */
+    ///@{
+    /**
+     * \brief A candidate move of the path relinking: a block of keys taken
+     * from the guide (direct IPR), or an exchange of two keys
+     * (permutation-based IPR).
+     */
+    struct IprCandidate {
+        /// The fitness of the candidate.
+        fitness_t fitness {FITNESS_T_MAX};
+
+        /// Index of the block (direct IPR) or the key (permutation IPR).
+        std::size_t key_index {0};
+
+        /// Positions of the exchanged keys (permutation IPR).
+        std::size_t pos1 {0};
+        std::size_t pos2 {0};
+
+        /// Indicates whether the fitness is only a bound.
+        bool bounded {false};
+    };
+
+    /**
+     * \brief Buffer where the IPR candidates are built: one per decoding
+     * slot, or one per candidate of a step when they are materialized (see
+     * BrkgaParams::pr_streaming).
+     */
+    struct IprCandidateBuffer {
+        /// The last candidate built in this buffer.
+        Chromosome chr {};
+
+        /// Relinking whose path point the buffer holds.
+        std::size_t pair_index {0};
+
+        /// Path (0 or 1) whose point the buffer holds; 2 means invalid.
+        unsigned side {2};
+
+        /// Version of the path point copied into the buffer.
+        std::size_t version {0};
+
+        /// Block applied on top of the path point (direct IPR).
+        std::size_t key_index {0};
+    };
+
+    /// A candidate of a decoding batch of the IPR.
+    struct IprBatchEntry {
+        /// Relinking of the candidate.
+        std::size_t relink {0};
+
+        /// Move of the current step, or block or key of the next step.
+        std::size_t move {0};
+
+        /// Indicates whether the candidate belongs to the next step (see
+        /// BrkgaParams::pr_speculative).
+        bool ahead {false};
+    };
+
+    /**
+     * \brief Relinking of one elite pair: both paths between its
+     * chromosomes, each one starting on one of them and walking towards
+     * the other.
      */
-    fitness_t getFitness(unsigned population_index, unsigned position) const;
-    ///@}
+    struct IprRelink {
+        /// Populations of the base and guide chromosomes.
+        unsigned pop_base {0};
+        unsigned pop_guide {0};
 
-    /** \name Parameter getters */
-    ///@{
-    const BrkgaParams& getBrkgaParams() const { return params; }
+        /// The base and guide chromosomes.
+        Chromosome ends[2];
 
-    Sense getOptimizationSense() const { return optimization_sense; }
+        /// Current point of each path, and its version.
+        Chromosome points[2];
+        std::size_t point_versions[2] {0, 0};
 
-    unsigned getChromosomeSize() const { return chromosome_size; }
+        /// Position of each key in the key order of each point
+        /// (permutation-based IPR).
+        std::vector<std::size_t> indices[2];
 
-    unsigned getEliteSize() const { return elite_size; }
+        /// Hamming signatures of both ends, and of the current point of
+        /// each path (direct IPR with the Hamming distance).
+        std::vector<std::uint64_t> end_signatures[2];
+        std::vector<std::uint64_t> point_signatures[2];
 
-    unsigned getNumMutants() const { return num_mutants; }
+        /// Kendall Tau rankings of the current point of each path (direct
+        /// IPR with the Kendall Tau distance).
+        KendallTauDistance::Ranking rankings[2];
 
-    bool evolutionaryIsMechanismOn() const { return evolutionary_mechanism_on; }
+        /// Blocks or keys still to be tested. The moves of the current step
+        /// come first, in the same order.
+        std::vector<std::size_t> remaining {};
 
-    unsigned getMaxThreads() const { return max_threads; }
+        /// Moves of the current step.
+        std::vector<IprCandidate> moves {};
+
+        /// Candidates of the next step decoded ahead of time, indexed by
+        /// block or key, and the step they were decoded for (speculative
+        /// IPR).
+        std::vector<IprCandidate> decoded_ahead {};
+        std::vector<std::size_t> decoded_ahead_steps {};
+
+        /// Path being walked in the current step.
+        unsigned side {0};
+
+        /// Number of steps done, and the maximum one.
+        std::size_t iterations {0};
+        std::size_t path_size {0};
+
+        /// Indicates whether the paths are still being walked.
+        bool active {false};
+
+        /// Indicates whether the paths were walked to the end, i.e., they
+        /// were not cut by the time limit.
+        bool completed {false};
+
+        /// Key of the pair in the memory of relinked pairs.
+        std::uint64_t pair_key {0};
+
+        /// Best solution found along the paths.
+        std::pair<fitness_t, Chromosome> best_found {};
+    };
+
+    /**
+     * \brief Distances between the elite individuals of two populations, or
+     * of one population to itself, indexed by rank.
+     *
+     * Individuals are identified by a fingerprint of their keys. When the
+     * cache is refreshed, the entries of individuals that remain elite are
+     * moved to their new ranks, and the others are computed on demand.
+     * The entries are kept only while the distance function and its
+     * parameters stay the same.
+     */
+    struct EliteDistanceCache {
+        /**
+         * \brief Distance function used to compute the entries. Holding it
+         * keeps its address from being taken by another function.
+         */
+        std::shared_ptr<DistanceFunctionBase> distance {};
+
+        /// Parameters of #distance when the entries were computed.
+        std::uint64_t distance_parameters {0};
+
+        /// Fingerprints of the elite individuals of each side, by rank.
+        std::vector<std::uint64_t> row_ids {};
+        std::vector<std::uint64_t> col_ids {};
+
+        /// Row-major distances; NaN if not computed yet.
+        std::vector<double> values {};
+
+        /**
+         * \brief Number of words of the Hamming signatures of each elite
+         * individual, by rank; zero if the distance is not the Hamming one.
+         */
+        std::size_t num_words {0};
+        std::vector<std::uint64_t> row_signatures {};
+        std::vector<std::uint64_t> col_signatures {};
+
+        /// Scratch space used to move the entries on refreshing.
+        std::vector<std::uint64_t> old_row_ids {};
+        std::vector<std::uint64_t> old_col_ids {};
+        std::vector<double> old_values {};
+        std::vector<std::pair<std::uint64_t, std::size_t>> sorted_ids {};
+        std::vector<std::size_t> row_map {};
+        std::vector<std::size_t> col_map {};
+    };
     ///@}
 
-protected:
     /** \name BRKGA Hyper-parameters */
     ///@{
     /// The BRKGA and IPR hyper-parameters.
@@ -2413,6 +4816,12 @@ protected:
     ///@{
     /// Number of threads for parallel decoding.
     const unsigned max_threads;
+
+    /// Maximum number of pending asynchronous decodings.
+    unsigned max_in_flight_decodes;
+
+    /// Total number of threads shared by the decodings (0 if not set).
+    unsigned decode_thread_budget;
     ///@}
 
     /** \name Engines */
@@ -2479,136 +4888,633 @@ protected:
      */
     std::vector<std::vector<double>> offspring_per_thread;
 
+    /**
+     * \brief Decode contexts, one per decoding slot, i.e., per thread, or per
+     * pending decoding when the decoder is asynchronous.
+     */
+    std::vector<DecodeContext> decode_contexts;
+
+    /**
+     * \brief For each offspring, the index of its top-ranked parent in the
+     * current population. Used to hint the key ordering of context-aware
+     * decoders.
+     */
+    std::vector<unsigned> offspring_dominant_parent;
+
+    /**
+     * \brief For each offspring, the positions whose keys did not come from
+     * its top-ranked parent.
+     */
+    std::vector<std::vector<unsigned>> offspring_foreign_positions;
+
     /// Indicates whether a initial population is set.
     bool initial_population;
 
     /// Indicates if the algorithm was proper initialized.
     bool initialized;
 
-    /// Holds the start time for a call of the path relink procedure.
-    std::chrono::system_clock::time_point pr_start_time;
-    ///@}
+    /// Holds the start time for a call of the path relink procedure.
+    std::chrono::system_clock::time_point pr_start_time;
+
+    /// Number of path relinking moves not decoded due to the sampled
+    /// neighborhoods.
+    unsigned num_pr_saved_decodes;
+
+    /// Number of chromosomes decoded by decodeBatch() so far.
+    std::size_t num_batch_decodes;
+
+    /// Tunes the block size of the path relinking, if enabled.
+    BlockSizeTuner block_size_tuner;
+
+    /// Elite pairs relinked recently, if enabled.
+    RelinkedPairMemory relinked_pairs;
+
+    /// Number of elite pairs skipped due to #relinked_pairs.
+    unsigned num_pr_skipped_pairs;
+    ///@}
+
+    /** \name Surrogate pre-screening */
+    ///@{
+    /// The surrogate model, if any.
+    std::shared_ptr<SurrogateModelBase> surrogate_model;
+
+    /// Fraction of the non-elite individuals decoded on each generation.
+    double surrogate_decode_fraction;
+
+    /// Cumulative counters of the pre-screening since construction.
+    struct {
+        unsigned num_decodes {0};
+        unsigned num_estimates {0};
+        unsigned num_promotions {0};
+    } surrogate_counters;
+
+    /// Indices of the individuals to be decoded during the pre-screening.
+    std::vector<unsigned> surrogate_candidates;
+    ///@}
+
+    /** \name Multi-fidelity decoding */
+    ///@{
+    /// Indicates whether multi-fidelity decoding is enabled.
+    bool multi_fidelity;
+
+    /// Fidelity requested to the decoder by the next decodings.
+    DecodeFidelity decode_fidelity;
+
+    /// Number of high-fidelity re-decodings of elite candidates.
+    unsigned num_high_fidelity_decodes;
+    ///@}
+
+    /** \name Bounded decoding */
+    ///@{
+    /// Indicates whether the next decodings have a cutoff.
+    bool use_decode_cutoff;
+
+    /// The cutoff handed to the decoder by the next decodings.
+    fitness_t decode_cutoff;
+
+    /// Number of decodings stopped early with a bound.
+    unsigned num_bounded_decodes;
+    ///@}
+
+    /** \name Path relinking workspace */
+    ///@{
+    /**
+     * \brief Buffers used by the path relinking. They are sized on the
+     * first call and reused by the following ones, so that the path
+     * relinking does not allocate memory in the steady state.
+     */
+    struct {
+        /// Draws the pairs of elite positions used as base and guide.
+        IprPairSampler pair_sampler;
+
+        /// Blocks whose replacement keeps the key order of the current
+        /// point (direct IPR with the Kendall Tau distance).
+        std::vector<std::size_t> deferred;
+
+        /// Keys paired with their positions, for sorting.
+        std::vector<std::pair<double, std::size_t>> sorted;
+
+        /// Buffers where the candidates are built.
+        std::vector<IprCandidateBuffer> buffers;
+
+        /// Distances from a new solution to the elite individuals.
+        std::vector<double> admission_distances;
+
+        /// Hamming signature of a new solution.
+        std::vector<std::uint64_t> admission_signature;
+
+        /// Relinkings whose paths are walked. Only the first `num_relinks`
+        /// are in use.
+        std::vector<IprRelink> relinks;
+        std::size_t num_relinks {0};
+
+        /// Candidates of the current decoding batch.
+        std::vector<IprBatchEntry> batch;
+
+        /// Indicates whether each move of the current step is decoded
+        /// (see BrkgaParams::pr_neighborhood).
+        std::vector<std::uint8_t> sampled;
+    } ipr_workspace;
+
+    /**
+     * \brief Elite distance caches, indexed by
+     * `pop_a * num_independent_populations + pop_b`. They are created on
+     * first use.
+     */
+    std::vector<EliteDistanceCache> elite_distances;
+    ///@}
+
+    /** \name Callbacks */
+    ///@{
+    /// Defines a custom stopping criteria supplied by the user.
+    std::function<bool(const AlgorithmStatus&)> stopping_criteria;
+
+    /** \brief Callback functions called when the best solution is improved.
+     * It must take a reference to AlgorithmStatus and return `true`
+     * if the algorithm should stop immediately.
+     */
+    std::vector<std::function<bool(const AlgorithmStatus&)>> info_callbacks;
+    ///@}
+
+    /** \name Ask/tell */
+    ///@{
+    /**
+     * \brief The open ask/tell session, if any. Declared last, so that
+     * the session is closed before any other member is destroyed.
+     */
+    std::unique_ptr<AskTellSession> ask_tell;
+    ///@}
+
+protected:
+    /** \name Core local methods */
+    ///@{
+    /**
+     * \brief Initializes the populations and others parameters of the
+     *        algorithm.
+     *
+     * If a initial population is supplied, this method completes the remain
+     * individuals, if they do not exist. This method also performs the initial
+     * decoding of the chromosomes. Therefore, depending on the decoder
+     * implementation, this can take a while, and the user may want to time
+     * such procedure in his/her experiments.
+     *
+     * \warning This method must be call before any population handling method.
+     *
+     * \warning As it is in #evolve(), the decoding is done in parallel using
+     *      threads, and the user **must guarantee that the decoder is
+     *      THREAD-SAFE.** If such property cannot be held, we suggest using
+     *      a single thread for optimization.
+     *
+     * \param reset when set true, it ignores all solutions provided
+     *        by #setInitialPopulation(), and builds a completely random
+     *        population. This parameter is set to true during reset phase.
+     *        When false, #initialize() considers all solutions given by
+     *        #setInitialPopulation().
+     */
+    void initialize(bool reset = false);
+
+    /**
+     * \brief Evolves the current population to the next.
+     *
+     * Note that the next population will be re-populate completely.
+     *
+     * \param[in] curr current population.
+     * \param[out] next next population.
+     */
+    void evolution(Population& curr, Population& next);
+
+    /**
+     * \brief Decodes the most promising new individuals of `next`, according
+     * to the surrogate model, and flags the others as approximate.
+     *
+     * \param curr current population, the parents.
+     * \param next next population, already mated.
+     */
+    void surrogateDecode(Population& curr, Population& next);
+
+    /**
+     * \brief Decodes, at high fidelity, the elite individuals holding
+     * surrogate estimates or low-fidelity fitness, re-sorting the population
+     * until the elite set is fully decoded. Then, releases the solution
+     * payloads of the non-elite individuals.
+     *
+     * \param population a sorted population.
+     * \param parents the population from where `population` was mated,
+     *        if any.
+     */
+    void decodeApproximateElite(Population& population,
+                                const Population* parents = nullptr);
+
+    /**
+     * \brief Walks the paths of the relinkings in the IPR workspace, in
+     * lockstep, with the walker of `pr_type`.
+     *
+     * The candidates are built in the buffers of the IPR workspace (see
+     * #prepareIprBuffers()), and those not better than the worst elite
+     * individual of their base population are of no use. Since the paths
+     * share the decoding batches, the loosest cutoff of their base
+     * populations is used.
+     *
+     * The parameters are the same of #pathRelink().
+     */
+    void walkIprPaths(PathRelinking::Type pr_type, DistanceFunctionBase& dist,
+                      std::size_t block_size, std::chrono::seconds max_time);
+
+    /**
+     * \brief Performs the direct path relinking of the relinkings in the IPR
+     * workspace.
+     *
+     * This method changes each allele or block of alleles of base chromosome
+     * for the correspondent one in the guide chromosome. Both paths of each
+     * relinking start on its chromosomes and walk towards the other one, in
+     * alternate steps. The candidates of a step, i.e., the current point of
+     * a path with one block from the guide, are decoded in parallel, and the
+     * candidates of all relinkings share the same batch. Then, the best one
+     * of each relinking is committed (see #commitIprStep()).
+     *
+     * The distance is a template parameter, so that the per-block checks
+     * of the built-in distances are resolved at compile time and can be
+     * inlined (see #dispatchDistance()). For the Hamming distance, the
+     * blocks are checked on the signatures of the chromosomes. For the
+     * Kendall Tau distance, the blocks that keep the key order of the
+     * current point are not decoded, but they are kept for the next steps,
+     * since they may change the order once other blocks move.
+     *
+     * \tparam Distance the exact type of `dist`, or DistanceFunctionBase
+     *         for custom distances, which are called through virtual
+     *         dispatch.
+     * \param dist distance functor (distance between two chromosomes).
+     * \param block_size number of alleles to be exchanged at once in each
+     *        iteration. If one, the traditional path relinking is performed.
+     * \param max_time abort path relinking when reach `max_time`.
+     *        If `max_time <= 0`, no limit is imposed.
+     * \param materialized if true, each candidate of a step is built in its
+     *        own buffer. Otherwise, each one is built in the buffer of its
+     *        decoding slot (see BrkgaParams::pr_streaming).
+     */
+    template <class Distance>
+    void directPathRelink(Distance& dist, std::size_t block_size,
+                          std::chrono::seconds max_time, bool materialized);
+
+    /**
+     * \brief Performs the permutation-based path relinking of the
+     * relinkings in the IPR workspace.
+     *
+     * In this method, the permutation induced by the keys in the guide
+     * solution is used to change the order of the keys in the permutation
+     * induced by the base solution. Each candidate is the current point of
+     * a path with one pair of keys swapped. The exchange is applied right
+     * before the decoding, and undone after it. Otherwise, the paths are
+     * walked as in #directPathRelink().
+     *
+     * \param max_time abort path relinking when reach `max_time`.
+     *        If `max_time <= 0`, no limit is imposed.
+     * \param materialized if true, each candidate of a step is built in its
+     *        own buffer. Otherwise, each one is built in the buffer of its
+     *        decoding slot (see BrkgaParams::pr_streaming).
+     */
+    void permutatioBasedPathRelink(std::chrono::seconds max_time,
+                                   bool materialized);
+
+    /**
+     * \brief Performs the path relinking of several elite pairs at the
+     * same time (see BrkgaParams::pr_concurrent_pairs).
+     *
+     * From each pair of populations, in the same order as #pathRelink(), up
+     * to `pr_concurrent_pairs` qualifying elite pairs are taken. Then, all
+     * their paths are walked in lockstep (see #walkIprPaths()), so that the
+     * threads stay busy while the paths get short. Once all paths are done,
+     * the best solution of each one is admitted into its base population,
+     * in the order the pairs were taken, so the result does not depend on
+     * the thread scheduling.
+     *
+     * The parameters are the same of #pathRelink().
+     */
+    PathRelinking::PathRelinkingResult concurrentPathRelink(
+        PathRelinking::Type pr_type,
+        PathRelinking::Selection pr_selection,
+        const std::shared_ptr<DistanceFunctionBase>& dist,
+        unsigned number_pairs,
+        double minimum_distance,
+        std::size_t block_size,
+        std::chrono::seconds max_time,
+        double percentage
+    );
+
+    /**
+     * \brief Sets both paths of `relink` to start on its `ends`.
+     *
+     * The parameters are the same of #pathRelink().
+     */
+    void startIprRelink(IprRelink& relink, PathRelinking::Type pr_type,
+                        std::size_t block_size, double percentage);
+
+    /**
+     * \brief Takes a step on the path of `relink` being walked.
+     *
+     * The best candidate is located, exactly decoded candidates first,
+     * since bounded ones are no better than the cutoff. If no candidate was
+     * decoded, the first remaining move is taken. The move is committed into
+     * the path point, which is held if it is the best solution found. Then,
+     * the other path is walked in the next step.
+     *
+     * \param relink the relinking, whose `moves` are the candidates of the
+     *        step.
+     * \param commit applies the block or key given to the path point.
+     * \param times_up indicates whether the time limit was reached.
+     */
+    template <class Commit>
+    void commitIprStep(IprRelink& relink, Commit&& commit, bool times_up);
+
+    /**
+     * \brief Makes sure that the IPR workspace has enough candidate buffers
+     * to decode the steps of its relinkings, and invalidates their contents.
+     *
+     * The buffers only grow, so after the first path relinking, it does not
+     * allocate memory anymore.
+     *
+     * \param materialized if true, one buffer per candidate of a step.
+     *        Otherwise, one buffer per decoding slot.
+     */
+    void prepareIprBuffers(bool materialized);
+
+    /**
+     * \brief Makes `buffer` hold the current point of the given path of the
+     * relinking `pair_index`, unless it does already.
+     *
+     * \returns true if the point was copied into the buffer. Otherwise, the
+     *          buffer holds the last candidate built there.
+     */
+    bool loadIprBuffer(IprCandidateBuffer& buffer, std::size_t pair_index,
+                       unsigned side);
+
+    /// Stores the fitness of the candidate `entry` decoded in `slot`.
+    void recordIprCandidate(const IprBatchEntry& entry, unsigned slot,
+                            fitness_t fitness);
+
+    /**
+     * \brief Returns true if the path relinking decodes candidates of the
+     * next steps in the idle slots (see BrkgaParams::pr_speculative).
+     *
+     * The sample of the next step is not known ahead of time, so sampled
+     * neighborhoods are not speculated. Within an ask/tell session, the
+     * whole batch is handed out at once, so no slot is left idle.
+     */
+    bool speculativeIpr() const;
+
+    /**
+     * \brief Returns the number of decoding slots left idle in the last
+     * round of a batch of `batch_size` candidates, if the path relinking is
+     * speculative, or zero otherwise.
+     */
+    std::size_t idleIprSlots(std::size_t batch_size) const;
+
+    /**
+     * \brief Chooses the moves decoded in a step of the path relinking
+     * (see BrkgaParams::pr_neighborhood), and counts the ones left out.
+     *
+     * \param num_moves the number of moves in the step.
+     * \returns flags telling whether each move is decoded.
+     */
+    const std::vector<std::uint8_t>& sampleIprMoves(std::size_t num_moves);
+
+    /**
+     * \brief Brings the elite distance cache between populations `pop_a`
+     * and `pop_b` up to date with their current elite sets.
+     *
+     * Entries of individuals that are still elite are kept. If `dist` is not
+     * the function used to compute the entries, or its parameters changed
+     * (see distanceParameters()), all of them are discarded.
+     *
+     * \returns the cache.
+     */
+    EliteDistanceCache& refreshEliteDistances(
+                            unsigned pop_a, unsigned pop_b,
+                            const std::shared_ptr<DistanceFunctionBase>& dist);
+
+    /**
+     * \brief Returns the distance between the elite individuals of ranks
+     * `rank_a` in population `pop_a` and `rank_b` in population `pop_b`,
+     * computing it only if it is not in the cache.
+     *
+     * The cache must have been refreshed by #refreshEliteDistances() since
+     * the populations were changed.
+     */
+    double eliteDistance(EliteDistanceCache& cache,
+                         unsigned pop_a, std::size_t rank_a,
+                         unsigned pop_b, std::size_t rank_b,
+                         DistanceFunctionBase& dist);
+
+    /**
+     * \brief Returns true if the elite individuals of ranks `rank_a` in
+     * population `pop_a` and `rank_b` in population `pop_b` are at least
+     * `minimum_distance` apart, using the cache as #eliteDistance().
+     *
+     * Distances of a SampledKendallTauDistance are estimates. When the
+     * estimate is within the error of the threshold, the exact distance
+     * decides, as in SampledKendallTauDistance::atLeast().
+     */
+    bool eliteFarEnough(EliteDistanceCache& cache,
+                        unsigned pop_a, std::size_t rank_a,
+                        unsigned pop_b, std::size_t rank_b,
+                        DistanceFunctionBase& dist, double minimum_distance);
+
+    /// Returns a 64-bit fingerprint of the keys of `chromosome`.
+    static std::uint64_t fingerprint(const Chromosome& chromosome);
+
+    /**
+     * \brief Returns a fingerprint of the parameters that change the values
+     * of `dist`: the threshold of a HammingDistance, and the error,
+     * failure probability, and seed of a SampledKendallTauDistance.
+     *
+     * It is zero for other functions, so a custom function must not change
+     * its values while in use; supply a new one instead.
+     */
+    static std::uint64_t distanceParameters(
+                                        const DistanceFunctionBase& dist);
+
+    /**
+     * \brief Returns `dist` as a HammingDistance if it is exactly one
+     * (not a derived class), or nullptr otherwise.
+     *
+     * In that case, distances and block checks are computed on the
+     * threshold signatures of the chromosomes.
+     */
+    static const HammingDistance* exactHamming(
+                                        const DistanceFunctionBase& dist);
+
+    /**
+     * \brief Computes the signatures of both ends of `relink`, and sets the
+     * signature of the current point of each path to its start.
+     */
+    static void prepareIprSignatures(const HammingDistance& hamming,
+                                     IprRelink& relink);
+
+    /**
+     * \brief Calls `work(dist)` with `dist` cast to its exact type if it is
+     * one of the built-in distances (HammingDistance or KendallTauDistance),
+     * or as DistanceFunctionBase otherwise.
+     *
+     * Therefore, `work` is instantiated for each built-in distance, and
+     * their calls in the IPR hot loops are not virtual. Classes derived from
+     * the built-in distances, as well as the custom ones, take the virtual
+     * path.
+     */
+    template <class Work>
+    static void dispatchDistance(DistanceFunctionBase& dist, Work&& work);
+
+    /**
+     * \brief Calls `dist.affectSolution()` over a block of keys, statically
+     * bound unless `Distance` is DistanceFunctionBase.
+     */
+    template <class Distance>
+    static bool affectsSolution(Distance& dist,
+                                Chromosome::const_iterator v1_begin,
+                                Chromosome::const_iterator v2_begin,
+                                std::size_t block_size);
+
+    /**
+     * \brief Re-decodes the best solution found by a path relinking, and
+     * puts it in place of the worst individual of `pop_base` if it is better
+     * than the best individual, or better than the worst elite individual
+     * and at least `minimum_distance` away from all elite individuals.
+     *
+     * \param pop_base the population of the base chromosome.
+     * \param pop_guide the population of the guide chromosome.
+     * \param best_found best solution found along the path. Its fitness is
+     *        FITNESS_T_MIN (maximization) or FITNESS_T_MAX (minimization)
+     *        if nothing was found.
+     * \param dist distance functor.
+     * \param minimum_distance minimum distance to the elite individuals.
+     * \returns the status of this path relinking.
+     */
+    PathRelinking::PathRelinkingResult admitPathRelinkingSolution(
+                        unsigned pop_base, unsigned pop_guide,
+                        std::pair<fitness_t, Chromosome>& best_found,
+                        const std::shared_ptr<DistanceFunctionBase>& dist,
+                        double minimum_distance);
 
-    /** \name Callbacks */
-    ///@{
-    /// Defines a custom stopping criteria supplied by the user.
-    std::function<bool(const AlgorithmStatus&)> stopping_criteria;
+    /**
+     * \brief Returns the block size of the next path relinking call made by
+     * run() or the short pathRelink(): the one chosen by the tuner (see
+     * BrkgaParams::pr_adaptive_block_size), or the one derived from
+     * BrkgaParams::alpha_block_size.
+     */
+    std::size_t nextIprBlockSize();
 
-    /** \brief Callback functions called when the best solution is improved.
-     * It must take a reference to AlgorithmStatus and return `true`
-     * if the algorithm should stop immediately.
+    /**
+     * \brief Returns the block size that identifies a relinking in
+     * #relinked_pairs: zero, i.e., any size, if the block size is tuned
+     * online (see BrkgaParams::pr_adaptive_block_size), or `block_size`.
      */
-    std::vector<std::function<bool(const AlgorithmStatus&)>> info_callbacks;
+    std::size_t pairMemoryBlockSize(std::size_t block_size) const;
+
+    /**
+     * \brief Reports the outcome of a path relinking call, which used the
+     * size given by nextIprBlockSize(), to the block size tuner.
+     *
+     * \param num_decodes number of decodings of the call.
+     * \param elapsed duration of the call.
+     * \param result result of the call.
+     */
+    void recordIprBlockSize(std::size_t num_decodes,
+                            std::chrono::duration<double> elapsed,
+                            PathRelinking::PathRelinkingResult result);
     ///@}
 
-protected:
-    /** \name Core local methods */
+    /** \name Decoding helpers */
     ///@{
     /**
-     * \brief Initializes the populations and others parameters of the
-     *        algorithm.
-     *
-     * If a initial population is supplied, this method completes the remain
-     * individuals, if they do not exist. This method also performs the initial
-     * decoding of the chromosomes. Therefore, depending on the decoder
-     * implementation, this can take a while, and the user may want to time
-     * such procedure in his/her experiments.
-     *
-     * \warning This method must be call before any population handling method.
+     * \brief Decodes a batch of chromosomes.
      *
-     * \warning As it is in #evolve(), the decoding is done in parallel using
-     *      threads, and the user **must guarantee that the decoder is
-     *      THREAD-SAFE.** If such property cannot be held, we suggest using
-     *      a single thread for optimization.
+     * All decodings of the framework go through this method. Within an
+     * ask/tell session, the batch is handed to the caller of ask(). Otherwise,
+     * for synchronous decoders, the batch is decoded in parallel using up to
+     * #max_threads threads, calling the context-aware method if the decoder
+     * implements it. For asynchronous decoders (see AsyncDecoder), up to
+     * #max_in_flight_decodes decodings are launched from the calling thread,
+     * and their results collected as they become ready.
      *
-     * \param reset when set true, it ignores all solutions provided
-     *        by #setInitialPopulation(), and builds a completely random
-     *        population. This parameter is set to true during reset phase.
-     *        When false, #initialize() considers all solutions given by
-     *        #setInitialPopulation().
+     * \param num_decodes the number of decodings in the batch.
+     * \param rewrite indicates whether the decoder may rewrite the chromosomes.
+     * \param prepare callback `Chromosome* prepare(std::size_t i,
+     *        unsigned slot)` that sets up the `i`-th decoding using the
+     *        decoding slot `slot`, and returns the chromosome to be decoded,
+     *        or `nullptr` to skip it.
+     * \param finish callback `void finish(std::size_t i, unsigned slot,
+     *        fitness_t fitness)` that receives the result of the `i`-th
+     *        decoding. For asynchronous decoders, it is always called from
+     *        the calling thread.
+     * \throws any exception thrown by the decoder, after all pending
+     *         decodings are done.
      */
-    void initialize(bool reset = false);
+    template <class Prepare, class Finish>
+    void decodeBatch(std::size_t num_decodes, bool rewrite,
+                     Prepare&& prepare, Finish&& finish);
 
     /**
-     * \brief Evolves the current population to the next.
+     * \brief Sets up the decode context of `slot` for a chromosome that does
+     *        not belong to a population.
      *
-     * Note that the next population will be re-populate completely.
-     *
-     * \param[in] curr current population.
-     * \param[out] next next population.
+     * \param chromosome the chromosome to be decoded.
+     * \param slot the decoding slot.
+     * \returns a pointer to `chromosome`.
      */
-    void evolution(Population& curr, Population& next);
+    Chromosome* bindChromosome(Chromosome& chromosome, unsigned slot);
 
     /**
-     * \brief Performs the direct path relinking.
-     *
-     * This method changes each allele or block of alleles of base chromosome
-     * for the correspondent one in the guide chromosome.
-     *
-     * This method is a multi-thread implementation. Instead of to build and
-     * decode each chromosome one at a time, the method builds a list of
-     * candidates, altering the alleles/keys according to the guide solution,
-     * and then decode all candidates in parallel. Note that
-     * `O(chromosome_size^2 / block_size)` additional memory is necessary to
-     * build the candidates, which can be costly if the `chromosome_size` is
-     * very large.
+     * \brief Sets up the decode context of `slot` for the chromosome of
+     *        `population` at index `chr_idx`.
      *
-     * \param chr1 first chromosome.
-     * \param chr2 second chromosome.
-     * \param dist distance functor (distance between two chromosomes).
-     * \param[out] best_found best solution found in the search.
-     * \param block_size number of alleles to be exchanged at once in each
-     *        iteration. If one, the traditional path relinking is performed.
-     * \param max_time abort path relinking when reach `max_time`.
-     *        If `max_time <= 0`, no limit is imposed.
-     * \param percentage define the size, in percentage, of the path to build.
+     * \param population the population.
+     * \param chr_idx the index of the chromosome (not its rank).
+     * \param slot the decoding slot.
+     * \param parents if not null, the population used to generate this
+     *        chromosome by mating. Used to hint the key ordering.
+     * \returns a pointer to the chromosome.
      */
-    void directPathRelink(
-        const Chromosome& chr1, const Chromosome& chr2,
-        std::shared_ptr<DistanceFunctionBase> dist,
-        std::pair<fitness_t, Chromosome>& best_found,
-        std::size_t block_size,
-        std::chrono::seconds max_time,
-        double percentage
-    );
+    Chromosome* bindIndividual(Population& population, unsigned chr_idx,
+                               unsigned slot,
+                               const Population* parents = nullptr);
 
     /**
-     * \brief Performs the permutation-based path relinking.
+     * \brief Decodes a chromosome that does not belong to a population,
+     * always at high fidelity and without cutoff.
      *
-     * In this method, the permutation induced by the keys in the guide
-     * solution is used to change the order of the keys in the permutation
-     * induced by the base solution.
-     *
-     * This method is a multi-thread implementation. Instead of to build and
-     * decode each chromosome one at a time, the method builds a list of
-     * candidates, altering the alleles/keys according to the guide solution,
-     * and then decode all candidates in parallel. Note that
-     * `O(chromosome_size^2 / block_size)` additional memory is necessary to
-     * build the candidates, which can be costly if the `chromosome_size` is
-     * very large.
+     * \param chromosome the chromosome to be decoded.
+     * \param rewrite indicates whether the decoder may rewrite the chromosome.
+     * \param[out] payload if not null, receives the solution payload
+     *        attached by the decoder, if any.
+     * \returns the fitness of the chromosome.
+     */
+    fitness_t decodeChromosome(
+        Chromosome& chromosome, bool rewrite,
+        std::shared_ptr<const std::any>* payload = nullptr);
+
+    /**
+     * \brief Indicates whether the last decoding on the given slot returned
+     * a bound instead of the exact fitness (see DecodeContext::cutoff()).
+     */
+    bool boundReported(unsigned slot) const;
+
+    /**
+     * \brief Flags the individual and counts the decoding if the last
+     * decoding on the given slot returned a bound (see #boundReported()).
+     */
+    void recordBound(unsigned slot);
+
+    /**
+     * \brief Decodes the chromosomes of `population` with indices in
+     *        `[first, last)`, and sets their fitness.
      *
-     * The path relinking is performed by changing the order of
-     * each allele of base chromosome for the correspondent one in
-     * the guide chromosome.
-     * \param chr1 first chromosome
-     * \param chr2 second chromosome
-     * \param dist distance functor (distance between two chromosomes)
-     * \param[out] best_found best solution found in the search
-     * \param block_size number of alleles to be exchanged at once in each
-     *        iteration. If one, the traditional path relinking is performed.
-     * \param max_time abort path relinking when reach `max_time`.
-     *        If `max_time <= 0`, no limit is imposed.
-     * \param percentage define the size, in percentage, of the path to
-     *        build. Default: 1.0 (100%)
+     * \param population the population.
+     * \param first index of the first chromosome.
+     * \param last one past the index of the last chromosome.
+     * \param parents if not null, the population used to generate these
+     *        chromosomes by mating. Used to hint the key ordering.
      */
-    void permutatioBasedPathRelink(
-        Chromosome& chr1, Chromosome& chr2,
-        std::shared_ptr<DistanceFunctionBase> dist,
-        std::pair<fitness_t, Chromosome>& best_found,
-        std::size_t block_size,
-        std::chrono::seconds max_time,
-        double percentage
-    );
+    void decodePopulation(Population& population, unsigned first,
+                          unsigned last, const Population* parents = nullptr);
     ///@}
 
     /** \name Helper functions */
@@ -2665,6 +5571,8 @@ BRKGA_MP_IPR<Decoder>::BRKGA_MP_IPR(
                     params.population_size - 1},
         evolutionary_mechanism_on {_evolutionary_mechanism_on},
         max_threads {_max_threads},
+        max_in_flight_decodes {_max_threads},
+        decode_thread_budget {0},
 
         // Internal data.
         decoder {_decoder_reference},
@@ -2707,11 +5615,37 @@ BRKGA_MP_IPR<Decoder>::BRKGA_MP_IPR(
                     ::value_type(_chromosome_size)
             ),
         #endif
+        decode_contexts(_max_threads),
+        offspring_dominant_parent(params.population_size,
+                                  std::numeric_limits<unsigned>::max()),
+        offspring_foreign_positions(params.population_size),
         initial_population {false},
         initialized {false},
         pr_start_time {},
+        num_pr_saved_decodes {0},
+        num_batch_decodes {0},
+        block_size_tuner {},
+        // Sampled neighborhoods walk a different path each time.
+        relinked_pairs {
+            (params.pr_neighborhood == PathRelinking::Neighborhood::FULL)?
+            params.pr_pair_memory_size : 0
+        },
+        num_pr_skipped_pairs {0},
+        surrogate_model {},
+        surrogate_decode_fraction {1.0},
+        surrogate_counters {},
+        surrogate_candidates {},
+        multi_fidelity {false},
+        decode_fidelity {DecodeFidelity::HIGH},
+        num_high_fidelity_decodes {0},
+        use_decode_cutoff {false},
+        decode_cutoff {},
+        num_bounded_decodes {0},
+        ipr_workspace {},
+        elite_distances {},
         stopping_criteria {},
-        info_callbacks {}
+        info_callbacks {},
+        ask_tell {}
 {
     using std::range_error;
     std::stringstream ss;
@@ -2776,11 +5710,36 @@ BRKGA_MP_IPR<Decoder>::BRKGA_MP_IPR(
         ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
            << "Path relinking percentage (" << params.pr_percentage
            << ") is not in the range (0, 1]";
+    else
+    if(params.pr_neighborhood == PathRelinking::Neighborhood::FIXED &&
+       params.pr_neighborhood_size == 0)
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Path relinking neighborhood size cannot be zero";
+    else
+    if(params.pr_adaptive_block_size &&
+       (params.pr_min_block_size == 0 ||
+        (params.pr_max_block_size > 0 &&
+         params.pr_max_block_size < params.pr_min_block_size)))
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Path relinking block size limits ["
+           << params.pr_min_block_size << ", " << params.pr_max_block_size
+           << "] are invalid";
 
     const auto str_error = ss.str();
     if(str_error.length() > 0)
         throw range_error(str_error);
 
+    // The sample of the distance built by readConfiguration() follows the
+    // seed. We use a copy, since the functor may be shared with other runs.
+    if(const auto sampled =
+           std::dynamic_pointer_cast<SampledKendallTauDistance>(
+               params.pr_distance_function);
+       sampled && sampled->use_algorithm_seed) {
+        auto reseeded = std::make_shared<SampledKendallTauDistance>(*sampled);
+        reseeded->seed = _seed;
+        params.pr_distance_function = reseeded;
+    }
+
     // Chooses the bias function.
     std::function<double(unsigned)> local_bias_function;
     switch(params.bias_type) {
@@ -2881,6 +5840,19 @@ const Chromosome& BRKGA_MP_IPR<Decoder>::getBestChromosome() const {
 
 //----------------------------------------------------------------------------//
 
+template <class Decoder>
+std::shared_ptr<const std::any> BRKGA_MP_IPR<Decoder>::getBestPayload() const {
+    unsigned best_k = 0;
+    for(unsigned i = 1; i < params.num_independent_populations; ++i)
+        if(betterThan(current[i]->getBestFitness(),
+                      current[best_k]->getBestFitness()))
+            best_k = i;
+
+    return current[best_k]->payloads[current[best_k]->fitness[0].second];
+}
+
+//----------------------------------------------------------------------------//
+
 template <class Decoder>
 fitness_t BRKGA_MP_IPR<Decoder>::getFitness(unsigned population_index,
                                             unsigned position) const {
@@ -2903,6 +5875,30 @@ fitness_t BRKGA_MP_IPR<Decoder>::getFitness(unsigned population_index,
 
 //----------------------------------------------------------------------------//
 
+template <class Decoder>
+bool BRKGA_MP_IPR<Decoder>::isFitnessApproximate(unsigned population_index,
+                                                 unsigned position) const {
+    if(population_index >= current.size()) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "The population index is larger than number of populations";
+        throw std::range_error(ss.str());
+    }
+
+    if(position >= params.population_size) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "The chromosome position is larger than number of populations";
+        throw std::range_error(ss.str());
+    }
+
+    const auto& population = *current[population_index];
+    return population.approximate_fitness[population.fitness[position].second]
+           != 0;
+}
+
+//----------------------------------------------------------------------------//
+
 template <class Decoder>
 const Chromosome& BRKGA_MP_IPR<Decoder>::getChromosome(
         unsigned population_index, unsigned position) const {
@@ -2951,11 +5947,20 @@ void BRKGA_MP_IPR<Decoder>::injectChromosome(const Chromosome& chromosome,
     }
 
     auto& pop = current[population_index];
-    auto& local_chr = pop->chromosomes[pop->fitness[position].second];
-    local_chr = chromosome;
-
-    pop->setFitness(position, decoder.decode(local_chr, true));
+    const auto chr_idx = pop->fitness[position].second;
+    pop->chromosomes[chr_idx] = chromosome;
+
+    decodeBatch(1, true,
+        [&](const std::size_t /*not-used*/, const unsigned slot) {
+            return bindIndividual(*pop, chr_idx, slot);
+        },
+        [&](const std::size_t /*not-used*/, const unsigned /*not-used*/,
+            const fitness_t fitness) {
+            pop->setFitness(position, fitness);
+        }
+    );
     pop->sortFitness(optimization_sense);
+    decodeApproximateElite(*pop);
 }
 
 //----------------------------------------------------------------------------//
@@ -3057,6 +6062,18 @@ void BRKGA_MP_IPR<Decoder>::exchangeElite(unsigned num_immigrants) {
                 std::copy(best_of_j.begin(), best_of_j.end(),
                           current[i]->getChromosome(dest).begin());
                 current[i]->fitness[dest].first = current[j]->fitness[m].first;
+
+                // Carry the key ordering along.
+                const auto src_idx = current[j]->fitness[m].second;
+                const auto dest_idx = current[i]->fitness[dest].second;
+                current[i]->key_order_valid[dest_idx] =
+                    current[j]->key_order_valid[src_idx];
+                if(current[j]->key_order_valid[src_idx] != 0)
+                    current[i]->key_orders[dest_idx] =
+                        current[j]->key_orders[src_idx];
+                current[i]->approximate_fitness[dest_idx] =
+                    current[j]->approximate_fitness[src_idx];
+                current[i]->payloads[dest_idx] = current[j]->payloads[src_idx];
                 --dest;
             }
         }
@@ -3128,6 +6145,12 @@ void BRKGA_MP_IPR<Decoder>::initialize(bool reset) {
             pop->fitness.resize(params.population_size);
         }
 
+        pop->key_orders.resize(params.population_size);
+        pop->key_order_valid.assign(params.population_size, 0);
+        pop->approximate_fitness.assign(params.population_size,
+                                        Population::EXACT_FITNESS);
+        pop->payloads.assign(params.population_size, nullptr);
+
         if(reset)
             pop->chromosomes.clear();
 
@@ -3147,14 +6170,11 @@ void BRKGA_MP_IPR<Decoder>::initialize(bool reset) {
     // Initialize and decode each chromosome of the current population,
     // then copy to previous.
     for(unsigned i = 0; i < params.num_independent_populations; ++i) {
-        #ifdef _OPENMP
-            #pragma omp parallel for num_threads(max_threads) schedule(static,1)
-        #endif
-        for(unsigned j = 0; j < params.population_size; ++j)
-            current[i]->setFitness(j, decoder.decode((*current[i])(j), true));
+        decodePopulation(*current[i], 0, params.population_size);
 
         // Sort and copy to previous.
         current[i]->sortFitness(optimization_sense);
+        decodeApproximateElite(*current[i]);
         previous[i].reset(new Population(*current[i]));
     }
 
@@ -3214,15 +6234,11 @@ void BRKGA_MP_IPR<Decoder>::shake(unsigned intensity,
                 pop[ne][k] = rand01(rng);
         }
 
-        #ifdef _OPENMP
-            #pragma omp parallel for num_threads(max_threads) schedule(static,1)
-        #endif
-        for(unsigned j = 0; j < params.population_size; ++j)
-            current[pop_start]->
-                setFitness(j, decoder.decode((*current[pop_start])(j), true));
+        decodePopulation(*current[pop_start], 0, params.population_size);
 
         // Now we must sort by fitness, since things might have changed.
         current[pop_start]->sortFitness(optimization_sense);
+        decodeApproximateElite(*current[pop_start]);
     }
 }
 
@@ -3248,6 +6264,9 @@ void BRKGA_MP_IPR<Decoder>::evolution(Population& curr,
     for(unsigned chr_idx = 0; chr_idx < elite_size; ++chr_idx) {
         next.chromosomes[chr_idx] = curr.chromosomes[curr.fitness[chr_idx].second];
         next.fitness[chr_idx] = std::make_pair(curr.fitness[chr_idx].first, chr_idx);
+        next.approximate_fitness[chr_idx] =
+            curr.approximate_fitness[curr.fitness[chr_idx].second];
+        next.payloads[chr_idx] = curr.payloads[curr.fitness[chr_idx].second];
     }
 
     // Second, we mate 'pop_size - elite_size - num_mutants' pairs.
@@ -3317,6 +6336,13 @@ void BRKGA_MP_IPR<Decoder>::evolution(Population& curr,
             std::sort(parents_ordered.begin(), parents_ordered.end(),
                       std::less<std::pair<fitness_t, unsigned>>());
 
+        // Keep track of the keys that do not come from the top-ranked
+        // parent. They are used to rebuild the key ordering of the offspring.
+        if constexpr(ContextAwareDecoder<Decoder>) {
+            offspring_dominant_parent[chr_idx] = parents_ordered[0].second;
+            offspring_foreign_positions[chr_idx].clear();
+        }
+
         // Performs the mate.
         for(unsigned allele = 0; allele < chromosome_size; ++allele) {
             // Roullete method.
@@ -3331,6 +6357,11 @@ void BRKGA_MP_IPR<Decoder>::evolution(Population& curr,
 
             // Decrement parent to the right index, and take the allele value.
             offspring[allele] = curr(parents_ordered[--parent].second, allele);
+
+            if constexpr(ContextAwareDecoder<Decoder>) {
+                if(parent != 0)
+                    offspring_foreign_positions[chr_idx].push_back(allele);
+            }
         }
 
         // This strategy of setting the offpring in a local variable, and then
@@ -3354,18 +6385,157 @@ void BRKGA_MP_IPR<Decoder>::evolution(Population& curr,
         #endif
         for(auto& allele : next.chromosomes[chr_idx])
             allele = rand01(rng);
+
+        if constexpr(ContextAwareDecoder<Decoder>)
+            offspring_dominant_parent[chr_idx] =
+                std::numeric_limits<unsigned>::max();
     }
 
-    // Time to compute fitness, in parallel.
-    #ifdef _OPENMP
-        #pragma omp parallel for num_threads(max_threads) schedule(static, 1)
-    #endif
-    for(auto i = elite_size; i < params.population_size; ++i) {
-        next.setFitness(i, decoder.decode(next.chromosomes[i], true));
+    // Time to compute fitness, in parallel. With a surrogate model, only the
+    // most promising individuals are decoded. Individuals not better than the
+    // worst elite of the current population cannot enter the next elite set.
+    use_decode_cutoff = true;
+    decode_cutoff = curr.fitness[elite_size - 1].first;
+
+    if(surrogate_model)
+        surrogateDecode(curr, next);
+    else
+        decodePopulation(next, elite_size, params.population_size, &curr);
+
+    use_decode_cutoff = false;
+
+    // The elite key orderings are moved to the next population, since the
+    // current one is overwritten in the next generation.
+    if constexpr(ContextAwareDecoder<Decoder>) {
+        for(unsigned chr_idx = 0; chr_idx < elite_size; ++chr_idx) {
+            const auto src_idx = curr.fitness[chr_idx].second;
+            std::swap(next.key_orders[chr_idx], curr.key_orders[src_idx]);
+            next.key_order_valid[chr_idx] = curr.key_order_valid[src_idx];
+            curr.key_order_valid[src_idx] = 0;
+        }
     }
 
     // Now we must sort by fitness, since things might have changed.
     next.sortFitness(optimization_sense);
+
+    decodeApproximateElite(next, &curr);
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::surrogateDecode(Population& curr,
+                                            Population& next) {
+    const unsigned first = elite_size;
+    const unsigned last = params.population_size;
+    auto& candidates = surrogate_candidates;
+    candidates.resize(last - first);
+    std::iota(candidates.begin(), candidates.end(), first);
+
+    unsigned num_decodes = last - first;
+    if(surrogate_model->ready()) {
+        #ifdef _OPENMP
+            #pragma omp parallel for num_threads(max_threads) schedule(static, 1)
+        #endif
+        for(unsigned i = first; i < last; ++i)
+            next.fitness[i] = std::make_pair(
+                surrogate_model->predict(next.chromosomes[i]), i);
+
+        // The most promising ones go first.
+        num_decodes = std::max(1u, static_cast<unsigned>(
+            std::ceil(surrogate_decode_fraction * (last - first))));
+        num_decodes = std::min(num_decodes, last - first);
+
+        std::partial_sort(candidates.begin(), candidates.begin() + num_decodes,
+                          candidates.end(),
+            [&](const unsigned a, const unsigned b) {
+                return betterThan(next.fitness[a].first,
+                                  next.fitness[b].first);
+            });
+    }
+
+    decodeBatch(num_decodes, true,
+        [&](const std::size_t i, const unsigned slot) {
+            return bindIndividual(next, candidates[i], slot, &curr);
+        },
+        [&](const std::size_t i, const unsigned /*not-used*/,
+            const fitness_t fitness) {
+            next.setFitness(candidates[i], fitness);
+        }
+    );
+
+    for(unsigned i = 0; i < num_decodes; ++i) {
+        if(next.approximate_fitness[candidates[i]] !=
+           Population::BOUNDED_FITNESS)
+            surrogate_model->update(next.chromosomes[candidates[i]],
+                                    next.fitness[candidates[i]].first);
+    }
+
+    for(unsigned i = num_decodes; i < candidates.size(); ++i)
+        next.approximate_fitness[candidates[i]] = Population::SURROGATE_FITNESS;
+
+    surrogate_counters.num_decodes += num_decodes;
+    surrogate_counters.num_estimates += candidates.size() - num_decodes;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::decodeApproximateElite(Population& population,
+                                                   const Population* parents) {
+    auto& positions = surrogate_candidates;
+    const auto previous_fidelity = decode_fidelity;
+    decode_fidelity = DecodeFidelity::HIGH;
+
+    for(;;) {
+        positions.clear();
+        for(unsigned i = 0; i < elite_size; ++i) {
+            const auto chr_idx = population.fitness[i].second;
+            switch(population.approximate_fitness[chr_idx]) {
+            case Population::SURROGATE_FITNESS:
+                ++surrogate_counters.num_promotions;
+                positions.push_back(i);
+                break;
+            case Population::LOW_FIDELITY_FITNESS:
+                ++num_high_fidelity_decodes;
+                positions.push_back(i);
+                break;
+            default:
+                break;
+            }
+        }
+
+        if(positions.empty())
+            break;
+
+        decodeBatch(positions.size(), true,
+            [&](const std::size_t i, const unsigned slot) {
+                return bindIndividual(population,
+                                      population.fitness[positions[i]].second,
+                                      slot, parents);
+            },
+            [&](const std::size_t i, const unsigned /*not-used*/,
+                const fitness_t fitness) {
+                population.fitness[positions[i]].first = fitness;
+            }
+        );
+
+        if(surrogate_model) {
+            for(const auto position : positions) {
+                const auto& [fitness, chr_idx] = population.fitness[position];
+                surrogate_model->update(population.chromosomes[chr_idx],
+                                        fitness);
+            }
+        }
+
+        population.sortFitness(optimization_sense);
+    }
+
+    decode_fidelity = previous_fidelity;
+
+    // Only the elite individuals keep their payloads.
+    for(unsigned i = elite_size; i < population.fitness.size(); ++i)
+        population.payloads[population.fitness[i].second].reset();
 }
 
 //----------------------------------------------------------------------------//
@@ -3394,6 +6564,70 @@ void BRKGA_MP_IPR<Decoder>::setStoppingCriteria(
 
 //----------------------------------------------------------------------------//
 
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::setMaxInFlightDecodes(
+        const unsigned max_in_flight) {
+    if(max_in_flight == 0) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "The maximum number of in-flight decodings must be positive.";
+        throw std::range_error(ss.str());
+    }
+
+    max_in_flight_decodes = max_in_flight;
+    if(decode_contexts.size() < max_in_flight)
+        decode_contexts.resize(max_in_flight);
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::setDecodeThreadBudget(const unsigned budget) {
+    decode_thread_budget = budget;
+
+    #ifdef _OPENMP
+    if(budget > 0 && omp_get_max_active_levels() < 2)
+        omp_set_max_active_levels(2);
+    #endif
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::setSurrogateModel(
+        std::shared_ptr<SurrogateModelBase> model,
+        const double decode_fraction) {
+    if(!(decode_fraction > 0.0 && decode_fraction <= 1.0)) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "The decode fraction must be in the interval (0, 1]. "
+           << "Given: " << decode_fraction;
+        throw std::range_error(ss.str());
+    }
+
+    surrogate_model = std::move(model);
+    surrogate_decode_fraction = decode_fraction;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::setMultiFidelity(const bool enable) {
+    if constexpr(!ContextAwareDecoder<Decoder>) {
+        if(enable) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "Multi-fidelity decoding requires a context-aware decoder.";
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    multi_fidelity = enable;
+    decode_fidelity = enable? DecodeFidelity::LOW : DecodeFidelity::HIGH;
+}
+
+//----------------------------------------------------------------------------//
+
 template <class Decoder>
 void BRKGA_MP_IPR<Decoder>::addNewSolutionObserver(
         const std::function<bool(const AlgorithmStatus&)>& func) {
@@ -3402,6 +6636,60 @@ void BRKGA_MP_IPR<Decoder>::addNewSolutionObserver(
 
 //----------------------------------------------------------------------------//
 
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::beginAskTell(std::function<void()> work) {
+    if(ask_tell) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "An ask/tell session is already open.";
+        throw std::runtime_error(ss.str());
+    }
+    // The work checks `ask_tell`. So, it is set before the driver starts.
+    ask_tell = std::make_unique<AskTellSession>();
+    try {
+        ask_tell->start(std::move(work));
+    }
+    catch(...) {
+        ask_tell.reset();
+        throw;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+EvaluationBatch BRKGA_MP_IPR<Decoder>::ask() {
+    if(!ask_tell) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "There is no open ask/tell session.";
+        throw std::runtime_error(ss.str());
+    }
+
+    auto batch = ask_tell->ask();
+    if(batch.empty()) {
+        // The work is done. Close the session before rethrowing any error.
+        const auto session = std::move(ask_tell);
+        session->finish();
+    }
+    return batch;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::tell(const std::vector<fitness_t>& fitness_values) {
+    if(!ask_tell) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "There is no open ask/tell session.";
+        throw std::runtime_error(ss.str());
+    }
+    ask_tell->tell(fitness_values);
+}
+
+//----------------------------------------------------------------------------//
+
 template <class Decoder>
 BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
         const ControlParams& control_params,
@@ -3464,6 +6752,13 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
     status.last_update_iteration = 0;
     status.largest_iteration_offset = 0;
 
+    // The surrogate counters are reported relative to this call.
+    const auto surrogate_counters_start = surrogate_counters;
+    const auto num_high_fidelity_decodes_start = num_high_fidelity_decodes;
+    const auto num_bounded_decodes_start = num_bounded_decodes;
+    const auto num_pr_saved_decodes_start = num_pr_saved_decodes;
+    const auto num_pr_skipped_pairs_start = num_pr_skipped_pairs;
+
     // This is the shaking multiplier, that generates a random number
     // within the bounds given by the user. Only used during shaking.
     auto random_shaking_multiplier = std::bind(
@@ -3531,6 +6826,21 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
         //----------------------------------------//
         evolve();
 
+        status.num_surrogate_decodes = surrogate_counters.num_decodes -
+            surrogate_counters_start.num_decodes;
+        status.num_surrogate_estimates = surrogate_counters.num_estimates -
+            surrogate_counters_start.num_estimates;
+        status.num_surrogate_promotions = surrogate_counters.num_promotions -
+            surrogate_counters_start.num_promotions;
+        status.num_high_fidelity_decodes = num_high_fidelity_decodes -
+            num_high_fidelity_decodes_start;
+        status.num_bounded_decodes = num_bounded_decodes -
+            num_bounded_decodes_start;
+        status.num_path_relink_saved_decodes = num_pr_saved_decodes -
+            num_pr_saved_decodes_start;
+        status.num_path_relink_skipped_pairs = num_pr_skipped_pairs -
+            num_pr_skipped_pairs_start;
+
         // Number of iterations without improvement.
         status.stalled_iterations =
             status.current_iteration - status.last_update_iteration;
@@ -3544,6 +6854,7 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
 
             status.best_fitness = fitness;
             status.best_chromosome = getBestChromosome();
+            status.best_payload = getBestPayload();
             status.last_update_iteration = status.current_iteration;
 
             if(status.largest_iteration_offset < status.stalled_iterations)
@@ -3571,13 +6882,7 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
            (status.stalled_iterations > 0) &&
            (status.stalled_iterations % control_params.ipr_interval == 0)) {
 
-            // OK, these numbers are also "well-known" values for IPR,
-            // and they were tuned using several situations.
-            std::size_t block_size = ceil(params.alpha_block_size *
-                                     sqrt(params.population_size));
-
-            if(block_size > chromosome_size)
-                block_size = chromosome_size / 2;
+            const std::size_t block_size = nextIprBlockSize();
 
             if(logger) {
                 *logger
@@ -3591,6 +6896,7 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
 
             status.num_path_relink_calls++;
             pr_start_time = std::chrono::system_clock::now();
+            const auto num_batch_decodes_start = num_batch_decodes;
 
             auto result = pathRelink(
                 params.pr_type,
@@ -3604,8 +6910,11 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
                 params.pr_percentage
             );
 
-            status.path_relink_time +=
+            const std::chrono::duration<double> pr_time =
                 std::chrono::system_clock::now() - pr_start_time;
+            status.path_relink_time += pr_time;
+            recordIprBlockSize(num_batch_decodes - num_batch_decodes_start,
+                               pr_time, result);
 
             status.current_time = std::chrono::system_clock::now() - start_time;
 
@@ -3660,6 +6969,7 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
 
                         status.best_fitness = fitness;
                         status.best_chromosome = getBestChromosome();
+                        status.best_payload = getBestPayload();
                         status.last_update_iteration = status.current_iteration;
 
                         if(status.largest_iteration_offset < status.stalled_iterations)
@@ -3733,16 +7043,18 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
                 }
 
                 // Re-decode only the needed chromosomes.
-                #ifdef _OPENMP
-                    #pragma omp parallel for num_threads(max_threads) schedule(static,1)
-                #endif
-                for(unsigned i = 0; i < shaken.size(); ++i) {
-                    const auto [pop_idx, chr_idx] = shaken[i];
-                    current[pop_idx]->setFitness(
-                        chr_idx,
-                        decoder.decode((*current[pop_idx])(chr_idx), true)
-                    );
-                }
+                decodeBatch(shaken.size(), true,
+                    [&](const std::size_t i, const unsigned slot) {
+                        const auto [pop_idx, chr_idx] = shaken[i];
+                        return bindIndividual(*current[pop_idx], chr_idx,
+                                              slot);
+                    },
+                    [&](const std::size_t i, const unsigned /*not-used*/,
+                        const fitness_t fitness) {
+                        const auto [pop_idx, chr_idx] = shaken[i];
+                        current[pop_idx]->setFitness(chr_idx, fitness);
+                    }
+                );
 
                 // Now we must sort by fitness, since things might have changed.
                 #ifdef _OPENMP
@@ -3750,6 +7062,9 @@ BRKGA::AlgorithmStatus BRKGA_MP_IPR<Decoder>::run(
                 #endif
                 for(unsigned i = 0; i < current.size(); ++i)
                     current[i]->sortFitness(optimization_sense);
+
+                for(unsigned i = 0; i < current.size(); ++i)
+                    decodeApproximateElite(*current[i]);
             }
 
             if(logger) {
@@ -3822,567 +7137,1690 @@ PathRelinking::PathRelinkingResult BRKGA_MP_IPR<Decoder>::pathRelink(
         throw std::range_error(ss.str());
     }
 
-    if(!initialized)
-        initialize();
+    if(!initialized)
+        initialize();
+
+    auto& rng = rng_per_thread[0];
+
+    // Perform path relinking between elite chromosomes from different
+    // populations. This is done in a circular fashion.
+    auto& pair_sampler = ipr_workspace.pair_sampler;
+
+    // Keep track of the time.
+    pr_start_time = std::chrono::system_clock::now();
+
+    // Within an ask/tell session, all candidates are handed out at once,
+    // so they must be materialized, one path at a time.
+    if(params.pr_concurrent_pairs > 0 && !ask_tell)
+        return concurrentPathRelink(pr_type, pr_selection, dist,
+                                    number_pairs, minimum_distance,
+                                    block_size, max_time, percentage);
+
+    // The paths of each pair are walked by the first relinking.
+    auto& relinks = ipr_workspace.relinks;
+    if(relinks.empty())
+        relinks.emplace_back();
+    auto& relink = relinks[0];
+
+    auto final_status = PR::TOO_HOMOGENEOUS;
+
+    for(unsigned pop_count = 0; pop_count < params.num_independent_populations;
+        ++pop_count) {
+        auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::seconds>
+            (std::chrono::system_clock::now() - pr_start_time);
+
+        if(elapsed_seconds > max_time)
+            break;
+
+        unsigned pop_base = pop_count;
+        unsigned pop_guide = pop_count + 1;
+        bool found_pair = false;
+        bool skipped_pair = false;
+
+        // If we have just one population, we take the both solution from it.
+        if(params.num_independent_populations == 1) {
+            pop_base = pop_guide = 0;
+            pop_count = params.num_independent_populations;
+        }
+        // If we have two populations, perform just one path relinking.
+        else if(params.num_independent_populations == 2) {
+            pop_count = params.num_independent_populations;
+        }
+
+        // Do the circular thing.
+        if(pop_guide == params.num_independent_populations)
+            pop_guide = 0;
+
+        // Relinking a chromosome with itself is useless.
+        const bool random_pairs =
+            pr_selection != PathRelinking::Selection::BESTSOLUTION;
+        pair_sampler.reset(elite_size, pop_base == pop_guide, random_pairs,
+                           rng);
+
+        auto& distances = refreshEliteDistances(pop_base, pop_guide, dist);
+
+        unsigned tested_pairs_count = 0;
+        if(number_pairs == 0)
+            number_pairs = pair_sampler.numPairs();
+
+        while(!pair_sampler.empty() && tested_pairs_count < number_pairs &&
+              elapsed_seconds < max_time) {
+            const auto [pos1, pos2] = pair_sampler.next();
+
+            // The path of a pair relinked recently would be the same.
+            // Such pairs do not count as tested.
+            const auto pair_key =
+                RelinkedPairMemory::key(distances.row_ids[pos1],
+                                        distances.col_ids[pos2], pr_type,
+                                        pairMemoryBlockSize(block_size),
+                                        percentage);
+            if(relinked_pairs.contains(pair_key)) {
+                ++num_pr_skipped_pairs;
+                skipped_pair = true;
+                continue;
+            }
+
+            const auto& chr1 = current[pop_base]->
+                    chromosomes[current[pop_base]->fitness[pos1].second];
+
+            const auto& chr2 = current[pop_guide]->
+                    chromosomes[current[pop_guide]->fitness[pos2].second];
+
+            if(eliteFarEnough(distances, pop_base, pos1, pop_guide, pos2,
+                              *dist, minimum_distance)) {
+                relink.ends[0] = chr1;
+                relink.ends[1] = chr2;
+                relink.pair_key = pair_key;
+                found_pair = true;
+                break;
+            }
+
+            ++tested_pairs_count;
+            elapsed_seconds =
+                std::chrono::duration_cast<std::chrono::seconds>
+                (std::chrono::system_clock::now() - pr_start_time);
+        }
+
+        // The elite sets are too homogeneous, we cannot do
+        // a good path relinking. Let's try other populations. If some pairs
+        // were skipped, their paths were walked already.
+        if(!found_pair) {
+            if(skipped_pair)
+                final_status |= PR::NO_IMPROVEMENT;
+            continue;
+        }
+
+        // Perform the path relinking.
+        relink.pop_base = pop_base;
+        relink.pop_guide = pop_guide;
+        startIprRelink(relink, pr_type, block_size, percentage);
+        ipr_workspace.num_relinks = 1;
+        walkIprPaths(pr_type, *dist, block_size, max_time);
+
+        // Paths cut by the time limit may be walked again.
+        if(relink.completed)
+            relinked_pairs.insert(relink.pair_key);
+
+        final_status |= admitPathRelinkingSolution(pop_base, pop_guide,
+                                                   relink.best_found, dist,
+                                                   minimum_distance);
+    }
+
+    return final_status;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+PathRelinking::PathRelinkingResult
+BRKGA_MP_IPR<Decoder>::admitPathRelinkingSolution(const unsigned pop_base,
+                        const unsigned pop_guide,
+                        std::pair<fitness_t, Chromosome>& best_found,
+                        const std::shared_ptr<DistanceFunctionBase>& dist,
+                        const double minimum_distance) {
+
+    using PR = PathRelinking::PathRelinkingResult;
+
+    auto final_status = PR::NO_IMPROVEMENT;
+
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
+    const auto fence = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+
+    // **NOTE:** is fitness_t contains float types, so the comparison
+    // `best_found.first == fence` may be unfase. Therefore, we use
+    // helper functions that define the correct behavior at compilation
+    // time.
+    if(close_enough(best_found.first, fence))
+        return final_status;
+
+    // Re-decode and apply local search if the decoder are able to do it.
+    std::shared_ptr<const std::any> best_found_payload;
+    best_found.first = decodeChromosome(best_found.second, true,
+                                        &best_found_payload);
+
+    // Now, check if the best solution found is really good.
+    // If it is the best, overwrite the worse solution in the population.
+    bool include_in_population =
+       (sense && best_found.first > current[pop_base]->fitness[0].first) ||
+       (!sense && best_found.first < current[pop_base]->fitness[0].first);
+
+    const auto best_overall = this->getBestFitness();
+
+    // Distances from the new solution to the elite individuals, kept to
+    // fill the cache if it is admitted.
+    auto& distances = refreshEliteDistances(pop_base, pop_guide, dist);
+    auto& admission_distances = ipr_workspace.admission_distances;
+    auto& signature = ipr_workspace.admission_signature;
+    admission_distances.resize(elite_size);
+    signature.resize(distances.num_words);
+    bool admission_checked = false;
+
+    if((sense && best_found.first > best_overall) ||
+       (!sense && best_found.first < best_overall))
+        final_status |= PR::BEST_IMPROVEMENT;
+
+    // If not the best, but is better than the worst elite member, check
+    // if the distance between this solution and all elite members
+    // is at least minimum_distance.
+    if(!include_in_population &&
+       ((sense && best_found.first >
+                    current[pop_base]->fitness[elite_size - 1].first) ||
+        (!sense && best_found.first <
+                    current[pop_base]->fitness[elite_size - 1].first))) {
+
+        if(distances.num_words > 0)
+            exactHamming(*dist)->signature(best_found.second,
+                                            signature.data());
+
+        const double threshold = minimum_distance - 1e-6;
+        include_in_population = true;
+        for(unsigned i = 0; i < elite_size; ++i) {
+            bool far_enough;
+            if(distances.num_words > 0) {
+                admission_distances[i] =
+                    double(HammingDistance::signatureDistance(
+                        signature.data(), distances.row_signatures.data() +
+                                          i * distances.num_words,
+                        distances.num_words));
+                far_enough = admission_distances[i] >= threshold;
+            }
+            else {
+                // Only the threshold matters, and most checks against
+                // a converged elite set fail early.
+                far_enough = dist->atLeast(best_found.second,
+                                current[pop_base]->getChromosome(i),
+                                threshold);
+            }
+
+            if(!far_enough) {
+                include_in_population = false;
+                final_status |= PR::NO_IMPROVEMENT;
+                break;
+            }
+        }
+
+        // The exact distances are known only from the signatures.
+        admission_checked = include_in_population &&
+                            distances.num_words > 0;
+    }
+
+    if(include_in_population) {
+        std::copy(begin(best_found.second), end(best_found.second),
+                  begin(current[pop_base]->
+                            chromosomes[current[pop_base]->
+                                fitness.back().second]));
+        current[pop_base]->
+            key_order_valid[current[pop_base]->fitness.back().second] = 0;
+        current[pop_base]->
+            approximate_fitness[current[pop_base]->fitness.back().second] =
+                Population::EXACT_FITNESS;
+        current[pop_base]->
+            payloads[current[pop_base]->fitness.back().second] =
+                std::move(best_found_payload);
+
+        current[pop_base]->fitness.back().first = best_found.first;
+        // Reorder the chromosomes.
+        current[pop_base]->sortFitness(optimization_sense);
+        final_status |= PR::ELITE_IMPROVEMENT;
+
+        // The distances from the new elite individual to the former
+        // ones are known already. After refreshing, `row_map` gives the
+        // former rank of each elite individual.
+        if(admission_checked && pop_base == pop_guide) {
+            refreshEliteDistances(pop_base, pop_base, dist);
+            const auto new_id = fingerprint(best_found.second);
+            const std::size_t new_rank =
+                std::find(distances.row_ids.begin(),
+                          distances.row_ids.end(), new_id) -
+                distances.row_ids.begin();
+
+            for(std::size_t k = 0; k < elite_size &&
+                                   new_rank < elite_size; ++k) {
+                const auto former_rank = distances.row_map[k];
+                if(k == new_rank || former_rank >= elite_size)
+                    continue;
+                distances.values[new_rank * elite_size + k] =
+                distances.values[k * elite_size + new_rank] =
+                    admission_distances[former_rank];
+            }
+        }
+    }
+
+    return final_status;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+PathRelinking::PathRelinkingResult BRKGA_MP_IPR<Decoder>::pathRelink(
+            std::shared_ptr<DistanceFunctionBase> dist,
+            std::chrono::seconds max_time) {
+
+    const auto start_time = std::chrono::system_clock::now();
+    const auto num_batch_decodes_start = num_batch_decodes;
+
+    const auto result = pathRelink(params.pr_type, params.pr_selection, dist,
+                                   params.pr_number_pairs,
+                                   params.pr_minimum_distance,
+                                   nextIprBlockSize(), max_time,
+                                   params.pr_percentage);
+
+    recordIprBlockSize(num_batch_decodes - num_batch_decodes_start,
+                       std::chrono::system_clock::now() - start_time, result);
+    return result;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+std::size_t BRKGA_MP_IPR<Decoder>::nextIprBlockSize() {
+    // OK, these numbers are also "well-known" values for IPR,
+    // and they were tuned using several situations.
+    std::size_t block_size = ceil(params.alpha_block_size *
+                                  sqrt(params.population_size));
+    if(block_size > chromosome_size)
+        block_size = chromosome_size / 2;
+
+    if(!params.pr_adaptive_block_size)
+        return block_size;
+
+    // The tuner starts from the default size.
+    if(block_size_tuner.getArms().empty()) {
+        const std::size_t max_size = (params.pr_max_block_size > 0)?
+                params.pr_max_block_size :
+                std::max<std::size_t>(1, chromosome_size / 2);
+        block_size_tuner.reset(block_size, params.pr_min_block_size,
+                               max_size);
+    }
+    return block_size_tuner.next();
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+std::size_t BRKGA_MP_IPR<Decoder>::pairMemoryBlockSize(
+                                        const std::size_t block_size) const {
+    return params.pr_adaptive_block_size? 0 : block_size;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::recordIprBlockSize(const std::size_t num_decodes,
+            const std::chrono::duration<double> elapsed,
+            const PathRelinking::PathRelinkingResult result) {
+    // Calls that decoded nothing, e.g., whose pairs were all skipped, say
+    // nothing about the block size.
+    if(params.pr_adaptive_block_size && num_decodes > 0)
+        block_size_tuner.update(num_decodes, elapsed.count(), result);
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::walkIprPaths(PathRelinking::Type pr_type,
+                                         DistanceFunctionBase& dist,
+                                         std::size_t block_size,
+                                         std::chrono::seconds max_time) {
+    auto& relinks = ipr_workspace.relinks;
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
+
+    // Candidates not better than the worst elite are of no use.
+    fitness_t cutoff = sense? FITNESS_T_MAX : FITNESS_T_MIN;
+    for(std::size_t r = 0; r < ipr_workspace.num_relinks; ++r) {
+        const auto worst_elite =
+            current[relinks[r].pop_base]->fitness[elite_size - 1].first;
+        if((sense && worst_elite < cutoff) || (!sense && worst_elite > cutoff))
+            cutoff = worst_elite;
+    }
+
+    use_decode_cutoff = true;
+    decode_cutoff = cutoff;
+
+    // Within an ask/tell session, all candidates are handed out at once,
+    // so they must be materialized.
+    const bool materialized = !params.pr_streaming || ask_tell;
+    prepareIprBuffers(materialized);
+
+    if(pr_type == PathRelinking::Type::DIRECT)
+        dispatchDistance(dist, [&](auto& distance) {
+            directPathRelink(distance, block_size, max_time, materialized);
+        });
+    else
+        permutatioBasedPathRelink(max_time, materialized);
+
+    use_decode_cutoff = false;
+}
+
+//----------------------------------------------------------------------------//
+
+// This is a multi-thread version. For small chromosomes, it may be slower than
+// single thread version.
+template <class Decoder>
+template <class Distance>
+void BRKGA_MP_IPR<Decoder>::directPathRelink(Distance& dist,
+                                             std::size_t block_size,
+                                             std::chrono::seconds max_time,
+                                             const bool materialized) {
+    auto& ws = ipr_workspace;
+    auto& relinks = ws.relinks;
+    const std::size_t num_relinks = ws.num_relinks;
+    auto& buffers = ws.buffers;
+    auto& batch = ws.batch;
+
+    const auto block_length = [&](const std::size_t block_base) {
+        return (block_base + block_size > chromosome_size)?
+               chromosome_size - block_base : block_size;
+    };
+
+    // For the Hamming distance, blocks are checked on the signatures.
+    constexpr bool hamming = std::is_same_v<Distance, HammingDistance>;
+
+    // For the Kendall Tau distance, the blocks that keep the key order of
+    // the current point are not decoded, but they are kept for the next
+    // steps, since they may change the order once other blocks move.
+    constexpr bool kendall = std::is_same_v<Distance, KendallTauDistance>;
+    auto& deferred = ws.deferred;
+    deferred.reserve(chromosome_size);
+
+    for(std::size_t r = 0; r < num_relinks; ++r) {
+        auto& relink = relinks[r];
+        if constexpr(hamming)
+            prepareIprSignatures(dist, relink);
+        if constexpr(kendall)
+            for(unsigned side = 0; side < 2; ++side)
+                KendallTauDistance::ranking(relink.ends[side],
+                                            relink.rankings[side]);
+    }
+
+    // Checks whether a guide block changes the point of the given path.
+    const auto affects = [&](const IprRelink& relink, const unsigned side,
+                             const std::size_t block_index) {
+        const auto block_base = block_index * block_size;
+        if constexpr(hamming)
+            return HammingDistance::signaturesDiffer(
+                relink.point_signatures[side].data(),
+                relink.end_signatures[1 - side].data(), block_base,
+                block_length(block_base));
+        else
+            return affectsSolution(dist,
+                                   relink.points[side].begin() + block_base,
+                                   relink.ends[1 - side].begin() + block_base,
+                                   block_length(block_base));
+    };
+
+    // Checks whether a guide block changes the key order of the point of the
+    // given path. Only the Kendall Tau distance tells them apart.
+    const auto changes_order = [&](IprRelink& relink, const unsigned side,
+                                   const std::size_t block_index) {
+        if constexpr(kendall) {
+            const auto block_base = block_index * block_size;
+            return KendallTauDistance::blockChangesOrder(
+                        relink.rankings[side],
+                        relink.ends[1 - side].begin() + block_base,
+                        block_base, block_length(block_base));
+        }
+        else
+            return true;
+    };
+
+    const bool speculative = speculativeIpr();
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
+
+    bool walking = true;
+    while(walking) {
+        // Gather the blocks of all paths. The blocks that do not affect the
+        // solution are dropped, and the deferred ones go after the
+        // candidates.
+        batch.clear();
+        for(std::size_t r = 0; r < num_relinks; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active)
+                continue;
+
+            const auto side = relink.side;
+            auto& remaining = relink.remaining;
+            auto& moves = relink.moves;
+
+            std::size_t num_remaining = 0;
+            for(std::size_t j = 0; j < remaining.size(); ++j) {
+                const auto block_index = remaining[j];
+                if(!affects(relink, side, block_index))
+                    continue;
+
+                if(!changes_order(relink, side, block_index)) {
+                    deferred.push_back(block_index);
+                    continue;
+                }
+                remaining[num_remaining++] = block_index;
+            }
+            remaining.resize(num_remaining);
+            remaining.insert(remaining.end(), deferred.begin(),
+                             deferred.end());
+            deferred.clear();
+
+            if(remaining.empty()) {
+                relink.active = false;
+                relink.completed = true;
+                continue;
+            }
+
+            moves.resize(num_remaining);
+            for(std::size_t i = 0; i < moves.size(); ++i) {
+                moves[i].key_index = remaining[i];
+                moves[i].fitness = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+                moves[i].bounded = true;
+            }
+
+            // The candidates decoded ahead in the previous step are reused.
+            // The others in the sample go to the batch.
+            const auto& sampled = sampleIprMoves(moves.size());
+            for(std::size_t i = 0; i < moves.size(); ++i) {
+                const auto block_index = moves[i].key_index;
+                if(speculative &&
+                   relink.decoded_ahead_steps[block_index] ==
+                   relink.iterations) {
+                    const auto& ahead = relink.decoded_ahead[block_index];
+                    moves[i].fitness = ahead.fitness;
+                    moves[i].bounded = ahead.bounded;
+                }
+                else
+                if(sampled[i])
+                    batch.push_back({r, i, false});
+            }
+        }
+
+        // The slots left idle in the last round of decodings take candidates
+        // of the next steps, which move the point of the other path of each
+        // relinking. That point does not change in this step, but the winner
+        // of this step leaves the next one, so one of these decodings may be
+        // wasted.
+        auto num_idle = idleIprSlots(batch.size());
+        for(std::size_t r = 0; r < num_relinks && num_idle > 0; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active || relink.iterations > relink.path_size ||
+               relink.remaining.size() < 2)
+                continue;
+
+            const auto side = 1 - relink.side;
+            for(std::size_t j = 0;
+                j < relink.remaining.size() && num_idle > 0; ++j) {
+                const auto block_index = relink.remaining[j];
+                if(!affects(relink, side, block_index) ||
+                   !changes_order(relink, side, block_index))
+                    continue;
+
+                relink.decoded_ahead[block_index].key_index = block_index;
+                batch.push_back({r, block_index, true});
+                --num_idle;
+            }
+        }
+
+        // Decode the candidates, building each one on its buffer.
+        volatile bool times_up = false;
+        decodeBatch(batch.size(), false,
+            [&](const std::size_t k, const unsigned slot) -> Chromosome* {
+                if(times_up) return nullptr;
+
+                const auto& entry = batch[k];
+                const auto& relink = relinks[entry.relink];
+                const auto side = entry.ahead? 1 - relink.side : relink.side;
+                const auto block_index = entry.ahead? entry.move :
+                        relink.moves[entry.move].key_index;
+
+                auto& buffer = buffers[materialized? k : slot];
+                if(!loadIprBuffer(buffer, entry.relink, side)) {
+                    // Restore the block of the previous candidate.
+                    const auto block_base = buffer.key_index * block_size;
+                    std::copy_n(relink.points[side].begin() + block_base,
+                                block_length(block_base),
+                                buffer.chr.begin() + block_base);
+                }
+
+                const auto block_base = block_index * block_size;
+                std::copy_n(relink.ends[1 - side].begin() + block_base,
+                            block_length(block_base),
+                            buffer.chr.begin() + block_base);
+                buffer.key_index = block_index;
+
+                return bindChromosome(buffer.chr, slot);
+            },
+            [&](const std::size_t k, const unsigned slot,
+                const fitness_t value) {
+                recordIprCandidate(batch[k], slot, value);
+
+                const auto elapsed_seconds =
+                     std::chrono::duration_cast<std::chrono::seconds>
+                     (std::chrono::system_clock::now() - pr_start_time);
+                if(elapsed_seconds > max_time)
+                    times_up = true;
+            }
+        );
+
+        const auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::seconds>
+            (std::chrono::system_clock::now() - pr_start_time);
+
+        // Take a step on each path, copying the best block into its point.
+        walking = false;
+        for(std::size_t r = 0; r < num_relinks; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active)
+                continue;
+
+            commitIprStep(relink, [&](const std::size_t block_index) {
+                const auto side = relink.side;
+                const auto block_base = block_index * block_size;
+                const auto bs = block_length(block_base);
+                const auto block = relink.ends[1 - side].begin() + block_base;
+                std::copy_n(block, bs,
+                            relink.points[side].begin() + block_base);
+
+                if constexpr(kendall)
+                    KendallTauDistance::replaceBlock(relink.rankings[side],
+                                                     block, block_base, bs);
+
+                if constexpr(hamming)
+                    HammingDistance::copySignatureBits(
+                        relink.end_signatures[1 - side].data(),
+                        relink.point_signatures[side].data(), block_base, bs);
+            }, elapsed_seconds > max_time);
+
+            walking |= relink.active;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::permutatioBasedPathRelink(
+                                        std::chrono::seconds max_time,
+                                        const bool materialized) {
+    auto& ws = ipr_workspace;
+    auto& relinks = ws.relinks;
+    const std::size_t num_relinks = ws.num_relinks;
+    auto& buffers = ws.buffers;
+    auto& batch = ws.batch;
+
+    const bool speculative = speculativeIpr();
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
+
+    bool walking = true;
+    while(walking) {
+        // Gather the exchanges of all paths. The keys already in place are
+        // dropped.
+        batch.clear();
+        for(std::size_t r = 0; r < num_relinks; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active)
+                continue;
+
+            const auto& base_indices = relink.indices[relink.side];
+            const auto& guide_indices = relink.indices[1 - relink.side];
+            auto& remaining = relink.remaining;
+            auto& moves = relink.moves;
+
+            moves.resize(remaining.size());
+            std::size_t num_remaining = 0;
+            for(std::size_t j = 0; j < remaining.size(); ++j) {
+                const auto key_index = remaining[j];
+                const auto position_in_base = base_indices[key_index];
+                const auto position_in_guide = guide_indices[key_index];
+
+                if(position_in_base == position_in_guide)
+                    continue;
+
+                auto& exchange = moves[num_remaining];
+                exchange.key_index = key_index;
+                exchange.pos1 = position_in_base;
+                exchange.pos2 = position_in_guide;
+                exchange.fitness = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+                exchange.bounded = true;
+                remaining[num_remaining++] = key_index;
+            }
+            remaining.resize(num_remaining);
+            moves.resize(num_remaining);
+
+            if(moves.empty()) {
+                relink.active = false;
+                relink.completed = true;
+                continue;
+            }
+
+            // The candidates decoded ahead in the previous step are reused,
+            // unless the commit of that step moved the keys they exchange.
+            // The others in the sample go to the batch.
+            const auto& sampled = sampleIprMoves(moves.size());
+            for(std::size_t i = 0; i < moves.size(); ++i) {
+                auto& exchange = moves[i];
+                const auto key_index = exchange.key_index;
+                if(speculative &&
+                   relink.decoded_ahead_steps[key_index] ==
+                   relink.iterations) {
+                    const auto& ahead = relink.decoded_ahead[key_index];
+                    if(ahead.pos1 == exchange.pos1 &&
+                       ahead.pos2 == exchange.pos2) {
+                        exchange.fitness = ahead.fitness;
+                        exchange.bounded = ahead.bounded;
+                        continue;
+                    }
+                }
+
+                if(sampled[i])
+                    batch.push_back({r, i, false});
+            }
+        }
+
+        // The slots left idle in the last round of decodings take candidates
+        // of the next steps, which move the point of the other path of each
+        // relinking (see directPathRelink()).
+        auto num_idle = idleIprSlots(batch.size());
+        for(std::size_t r = 0; r < num_relinks && num_idle > 0; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active || relink.iterations > relink.path_size ||
+               relink.remaining.size() < 2)
+                continue;
+
+            const auto side = 1 - relink.side;
+            for(std::size_t j = 0;
+                j < relink.remaining.size() && num_idle > 0; ++j) {
+                const auto key_index = relink.remaining[j];
+                auto& ahead = relink.decoded_ahead[key_index];
+                ahead.key_index = key_index;
+                ahead.pos1 = relink.indices[side][key_index];
+                ahead.pos2 = relink.indices[1 - side][key_index];
+                if(ahead.pos1 == ahead.pos2)
+                    continue;
+
+                batch.push_back({r, key_index, true});
+                --num_idle;
+            }
+        }
+
+        // Decode the candidates. The keys are swapped back once the
+        // decoding is done.
+        volatile bool times_up = false;
+        decodeBatch(batch.size(), false,
+            [&](const std::size_t k, const unsigned slot) -> Chromosome* {
+                if(times_up) return nullptr;
+
+                const auto& entry = batch[k];
+                const auto& relink = relinks[entry.relink];
+                const auto& exchange = entry.ahead?
+                        relink.decoded_ahead[entry.move] :
+                        relink.moves[entry.move];
+
+                auto& buffer = buffers[materialized? k : slot];
+                loadIprBuffer(buffer, entry.relink,
+                              entry.ahead? 1 - relink.side : relink.side);
+
+                std::swap(buffer.chr[exchange.pos1],
+                          buffer.chr[exchange.pos2]);
+                return bindChromosome(buffer.chr, slot);
+            },
+            [&](const std::size_t k, const unsigned slot,
+                const fitness_t value) {
+                const auto& entry = batch[k];
+                const auto& relink = relinks[entry.relink];
+                const auto& exchange = entry.ahead?
+                        relink.decoded_ahead[entry.move] :
+                        relink.moves[entry.move];
+
+                auto& buffer = buffers[materialized? k : slot];
+                std::swap(buffer.chr[exchange.pos1],
+                          buffer.chr[exchange.pos2]);
+
+                recordIprCandidate(entry, slot, value);
+
+                const auto elapsed_seconds =
+                        std::chrono::duration_cast<std::chrono::seconds>
+                        (std::chrono::system_clock::now() - pr_start_time);
+                if(elapsed_seconds > max_time)
+                    times_up = true;
+            }
+        );
+
+        const auto elapsed_seconds =
+            std::chrono::duration_cast<std::chrono::seconds>
+            (std::chrono::system_clock::now() - pr_start_time);
+
+        // Take a step on each path, committing the best exchange into its
+        // point.
+        walking = false;
+        for(std::size_t r = 0; r < num_relinks; ++r) {
+            auto& relink = relinks[r];
+            if(!relink.active)
+                continue;
+
+            commitIprStep(relink, [&](const std::size_t key_index) {
+                auto& point = relink.points[relink.side];
+                auto& base_indices = relink.indices[relink.side];
+                const auto position_in_base = base_indices[key_index];
+                const auto position_in_guide =
+                        relink.indices[1 - relink.side][key_index];
+
+                std::swap(point[position_in_base], point[position_in_guide]);
+                std::swap(base_indices[position_in_base],
+                          base_indices[position_in_guide]);
+            }, elapsed_seconds > max_time);
+
+            walking |= relink.active;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+PathRelinking::PathRelinkingResult BRKGA_MP_IPR<Decoder>::concurrentPathRelink(
+                    PathRelinking::Type pr_type,
+                    PathRelinking::Selection pr_selection,
+                    const std::shared_ptr<DistanceFunctionBase>& dist,
+                    unsigned number_pairs,
+                    double minimum_distance,
+                    std::size_t block_size,
+                    std::chrono::seconds max_time,
+                    double percentage) {
+
+    using PR = PathRelinking::PathRelinkingResult;
 
+    auto& ws = ipr_workspace;
     auto& rng = rng_per_thread[0];
-    Chromosome initial_solution(chromosome_size);
-    Chromosome guiding_solution(chromosome_size);
-
-    // Perform path relinking between elite chromosomes from different
-    // populations. This is done in a circular fashion.
-    std::deque<std::pair<std::size_t, std::size_t>> index_pairs;
+    auto& pair_sampler = ws.pair_sampler;
+    auto& relinks = ws.relinks;
+    ws.num_relinks = 0;
 
-    // Keep track of the time.
-    pr_start_time = std::chrono::system_clock::now();
+    // As in pathRelink(), one and two populations give a single pair of
+    // populations, and more populations are paired in a circular fashion.
+    const unsigned num_pops = params.num_independent_populations;
+    const unsigned num_pop_pairs = (num_pops <= 2)? 1 : num_pops;
+    bool skipped_pair = false;
 
-    auto final_status = PR::TOO_HOMOGENEOUS;
+    for(unsigned pop_base = 0; pop_base < num_pop_pairs; ++pop_base) {
+        const unsigned pop_guide = (pop_base + 1) % num_pops;
 
-    for(unsigned pop_count = 0; pop_count < params.num_independent_populations;
-        ++pop_count) {
         auto elapsed_seconds =
             std::chrono::duration_cast<std::chrono::seconds>
             (std::chrono::system_clock::now() - pr_start_time);
-
         if(elapsed_seconds > max_time)
             break;
 
-        unsigned pop_base = pop_count;
-        unsigned pop_guide = pop_count + 1;
-        bool found_pair = false;
-
-        // If we have just one population, we take the both solution from it.
-        if(params.num_independent_populations == 1) {
-            pop_base = pop_guide = 0;
-            pop_count = params.num_independent_populations;
-        }
-        // If we have two populations, perform just one path relinking.
-        else if(params.num_independent_populations == 2) {
-            pop_count = params.num_independent_populations;
-        }
-
-        // Do the circular thing.
-        if(pop_guide == params.num_independent_populations)
-            pop_guide = 0;
+        pair_sampler.reset(elite_size, pop_base == pop_guide,
+                    pr_selection != PathRelinking::Selection::BESTSOLUTION,
+                    rng);
 
-        index_pairs.clear();
-        for(std::size_t i = 0; i < elite_size; ++i)
-            for(std::size_t j = 0; j < elite_size; ++j)
-                index_pairs.emplace_back(std::make_pair(i, j));
+        auto& distances = refreshEliteDistances(pop_base, pop_guide, dist);
 
+        const unsigned max_tested_pairs = (number_pairs == 0)?
+                                          unsigned(pair_sampler.numPairs()) :
+                                          number_pairs;
         unsigned tested_pairs_count = 0;
-        if(number_pairs == 0)
-            number_pairs = index_pairs.size();
+        unsigned num_found = 0;
 
-        while(!index_pairs.empty() && tested_pairs_count < number_pairs &&
+        while(!pair_sampler.empty() && tested_pairs_count < max_tested_pairs &&
+              num_found < params.pr_concurrent_pairs &&
               elapsed_seconds < max_time) {
-            const auto index =
-                    (pr_selection == PathRelinking::Selection::BESTSOLUTION?
-                     0 : randInt(index_pairs.size() - 1, rng));
-
-            const auto pos1 = index_pairs[index].first;
-            const auto pos2 = index_pairs[index].second;
-
-            const auto& chr1 = current[pop_base]->
-                    chromosomes[current[pop_base]->fitness[pos1].second];
-
-            const auto& chr2 = current[pop_guide]->
-                    chromosomes[current[pop_base]->fitness[pos2].second];
+            const auto [pos1, pos2] = pair_sampler.next();
+
+            const auto pair_key =
+                RelinkedPairMemory::key(distances.row_ids[pos1],
+                                        distances.col_ids[pos2], pr_type,
+                                        pairMemoryBlockSize(block_size),
+                                        percentage);
+            if(relinked_pairs.contains(pair_key)) {
+                ++num_pr_skipped_pairs;
+                skipped_pair = true;
+                continue;
+            }
 
-            if(dist->distance(chr1, chr2) >= minimum_distance - 1e-6) {
-                copy(begin(chr1), end(chr1), begin(initial_solution));
-                copy(begin(chr2), end(chr2), begin(guiding_solution));
-                found_pair = true;
-                break;
+            if(eliteFarEnough(distances, pop_base, pos1, pop_guide, pos2,
+                              *dist, minimum_distance)) {
+                if(relinks.size() == ws.num_relinks)
+                    relinks.emplace_back();
+                auto& relink = relinks[ws.num_relinks++];
+                relink.pair_key = pair_key;
+                relink.pop_base = pop_base;
+                relink.pop_guide = pop_guide;
+                relink.ends[0] = current[pop_base]->
+                        chromosomes[current[pop_base]->fitness[pos1].second];
+                relink.ends[1] = current[pop_guide]->
+                        chromosomes[current[pop_guide]->fitness[pos2].second];
+                ++num_found;
+                continue;
             }
 
-            index_pairs.erase(begin(index_pairs) + index);
             ++tested_pairs_count;
             elapsed_seconds =
                 std::chrono::duration_cast<std::chrono::seconds>
                 (std::chrono::system_clock::now() - pr_start_time);
         }
+    }
 
-        // The elite sets are too homogeneous, we cannot do
-        // a good path relinking. Let's try other populations.
-        if(!found_pair)
-            continue;
-
-        // Create a empty solution.
-        std::pair<fitness_t, Chromosome> best_found;
-        best_found.second.resize(current[0]->getChromosomeSize(), 0.0);
-
-        const bool sense = optimization_sense == Sense::MAXIMIZE;
-
-        best_found.first = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+    // The elite sets are too homogeneous, or the paths of their pairs were
+    // walked already.
+    if(ws.num_relinks == 0)
+        return skipped_pair? PR::NO_IMPROVEMENT : PR::TOO_HOMOGENEOUS;
 
-        const auto fence = best_found.first;
+    for(std::size_t r = 0; r < ws.num_relinks; ++r)
+        startIprRelink(relinks[r], pr_type, block_size, percentage);
 
-        // Perform the path relinking.
-        if(pr_type == PathRelinking::Type::DIRECT) {
-            directPathRelink(initial_solution, guiding_solution, dist,
-                             best_found, block_size, max_time, percentage);
-        }
-        else {
-            permutatioBasedPathRelink(initial_solution, guiding_solution, dist,
-                                      best_found, block_size, max_time,
-                                      percentage);
-        }
+    walkIprPaths(pr_type, *dist, block_size, max_time);
 
-        final_status |= PR::NO_IMPROVEMENT;
+    // Merge the solutions back, in the order the pairs were taken. Paths cut
+    // by the time limit may be walked again.
+    auto final_status = PR::TOO_HOMOGENEOUS;
+    for(std::size_t r = 0; r < ws.num_relinks; ++r) {
+        auto& relink = relinks[r];
+        if(relink.completed)
+            relinked_pairs.insert(relink.pair_key);
+
+        final_status |= admitPathRelinkingSolution(relink.pop_base,
+                                                   relink.pop_guide,
+                                                   relink.best_found, dist,
+                                                   minimum_distance);
+    }
+    return final_status;
+}
 
-        // **NOTE:** is fitness_t contains float types, so the comparison
-        // `best_found.first == fence` may be unfase. Therefore, we use
-        // helper functions that define the correct behavior at compilation
-        // time.
-        if(close_enough(best_found.first, fence))
-            continue;
+//----------------------------------------------------------------------------//
 
-        // Re-decode and apply local search if the decoder are able to do it.
-        best_found.first = decoder.decode(best_found.second, true);
-
-        // Now, check if the best solution found is really good.
-        // If it is the best, overwrite the worse solution in the population.
-        bool include_in_population =
-           (sense && best_found.first > current[pop_base]->fitness[0].first) ||
-           (!sense && best_found.first < current[pop_base]->fitness[0].first);
-
-        const auto best_overall = this->getBestFitness();
-
-        if((sense && best_found.first > best_overall) ||
-           (!sense && best_found.first < best_overall))
-            final_status |= PR::BEST_IMPROVEMENT;
-
-        // If not the best, but is better than the worst elite member, check
-        // if the distance between this solution and all elite members
-        // is at least minimum_distance.
-        if(!include_in_population &&
-           ((sense && best_found.first >
-                        current[pop_base]->fitness[elite_size - 1].first) ||
-            (!sense && best_found.first <
-                        current[pop_base]->fitness[elite_size - 1].first))) {
-
-            include_in_population = true;
-            for(unsigned i = 0; i < elite_size; ++i) {
-                if(dist->distance(best_found.second, current[pop_base]->
-                            chromosomes[current[pop_base]->fitness[i].second])
-                   < minimum_distance - 1e-6) {
-                    include_in_population = false;
-                    final_status |= PR::NO_IMPROVEMENT;
-                    break;
-                }
-            }
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::startIprRelink(IprRelink& relink,
+                                           PathRelinking::Type pr_type,
+                                           std::size_t block_size,
+                                           double percentage) {
+    const std::size_t num_moves = (pr_type == PathRelinking::Type::DIRECT)?
+            std::size_t(ceil((double)chromosome_size / block_size)) :
+            std::size_t(chromosome_size);
+
+    // Both paths start on the chromosomes of the pair, each one with the
+    // permutation induced by its keys.
+    auto& sorted = ipr_workspace.sorted;
+    sorted.resize(chromosome_size);
+
+    for(unsigned side = 0; side < 2; ++side) {
+        relink.points[side] = relink.ends[side];
+        relink.point_versions[side] = 0;
+
+        if(pr_type == PathRelinking::Type::PERMUTATION) {
+            for(std::size_t i = 0; i < chromosome_size; ++i)
+                sorted[i] = std::pair<double, std::size_t>(
+                                            relink.points[side][i], i);
+
+            std::sort(begin(sorted), end(sorted));
+            relink.indices[side].resize(chromosome_size);
+            for(std::size_t i = 0; i < chromosome_size; ++i)
+                relink.indices[side][i] = sorted[i].second;
         }
+    }
 
-        if(include_in_population) {
-            std::copy(begin(best_found.second), end(best_found.second),
-                      begin(current[pop_base]->
-                                chromosomes[current[pop_base]->
-                                    fitness.back().second]));
+    relink.remaining.resize(num_moves);
+    std::iota(relink.remaining.begin(), relink.remaining.end(), 0);
+    relink.moves.reserve(num_moves);
 
-            current[pop_base]->fitness.back().first = best_found.first;
-            // Reorder the chromosomes.
-            current[pop_base]->sortFitness(optimization_sense);
-            final_status |= PR::ELITE_IMPROVEMENT;
-        }
+    if(speculativeIpr()) {
+        relink.decoded_ahead.resize(num_moves);
+        relink.decoded_ahead_steps.assign(num_moves,
+                                    std::numeric_limits<std::size_t>::max());
     }
 
-    return final_status;
+    relink.side = 0;
+    relink.iterations = 0;
+    relink.path_size = std::size_t(percentage * num_moves);
+    relink.active = true;
+    relink.completed = false;
+
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
+    relink.best_found.first = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+    relink.best_found.second.resize(chromosome_size);
 }
 
 //----------------------------------------------------------------------------//
 
 template <class Decoder>
-PathRelinking::PathRelinkingResult BRKGA_MP_IPR<Decoder>::pathRelink(
-            std::shared_ptr<DistanceFunctionBase> dist,
-            std::chrono::seconds max_time) {
+template <class Commit>
+void BRKGA_MP_IPR<Decoder>::commitIprStep(IprRelink& relink, Commit&& commit,
+                                          const bool times_up) {
+    const bool sense = optimization_sense == Sense::MAXIMIZE;
 
-    size_t block_size = ceil(params.alpha_block_size *
-                             sqrt(params.population_size));
-    if(block_size > chromosome_size)
-        block_size = chromosome_size / 2;
+    // Locate the best candidate. Exactly decoded candidates come first,
+    // since bounded ones are no better than the cutoff.
+    std::size_t best_index = 0;
+    bool best_bounded = true;
+    fitness_t best_value = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+
+    for(std::size_t i = 0; i < relink.moves.size(); ++i) {
+        const auto& candidate = relink.moves[i];
+        if(candidate.bounded && !best_bounded)
+            continue;
+
+        if((best_bounded && !candidate.bounded) ||
+           (best_value < candidate.fitness && sense) ||
+           (best_value > candidate.fitness && !sense)) {
+            best_index = i;
+            best_value = candidate.fitness;
+            best_bounded = candidate.bounded;
+        }
+    }
 
-    return pathRelink(params.pr_type, params.pr_selection, dist,
-                      params.pr_number_pairs, params.pr_minimum_distance,
-                      block_size, max_time,
-                      params.pr_percentage);
+    // Commit the best move into the path point. If no move was a candidate,
+    // e.g., all blocks were deferred, the first one is taken.
+    const auto side = relink.side;
+    commit(relink.remaining[best_index]);
+    ++relink.point_versions[side];
+
+    // Hold it, if it is the best found until now.
+    auto& best_found = relink.best_found;
+    if(!best_bounded &&
+       ((sense && best_found.first < best_value) ||
+        (!sense && best_found.first > best_value))) {
+        best_found.first = best_value;
+        std::copy(begin(relink.points[side]), end(relink.points[side]),
+                  begin(best_found.second));
+    }
+
+    relink.side = 1 - side;
+    relink.remaining.erase(relink.remaining.begin() + best_index);
+
+    if(times_up)
+        relink.active = false;
+    else
+    if(relink.iterations++ > relink.path_size) {
+        relink.active = false;
+        relink.completed = true;
+    }
 }
 
 //----------------------------------------------------------------------------//
 
-// This is a multi-thread version. For small chromosomes, it may be slower than
-// single thread version.
 template <class Decoder>
-void BRKGA_MP_IPR<Decoder>::directPathRelink(
-            const Chromosome& chr1, const Chromosome& chr2,
-            std::shared_ptr<DistanceFunctionBase> dist,
-            std::pair<fitness_t, Chromosome>& best_found,
-            std::size_t block_size,
-            std::chrono::seconds max_time,
-            double percentage) {
-
-    const std::size_t num_blocks =
-            std::size_t(ceil((double)chr1.size() / block_size));
-    const std::size_t path_size = std::size_t(percentage * num_blocks);
-
-    // Create the set of indices to test.
-    std::set<std::size_t> remaining_blocks;
-    for(std::size_t i = 0; i < num_blocks; ++i)
-        remaining_blocks.insert(i);
-    Chromosome old_keys(chr1.size());
-
-    struct Triple {
-    public:
-        Chromosome chr;
-        fitness_t fitness;
-        std::size_t block_index;
-        Triple(): chr(), fitness(FITNESS_T_MAX), block_index(0) {}
-    };
+void BRKGA_MP_IPR<Decoder>::prepareIprBuffers(const bool materialized) {
+    auto& ws = ipr_workspace;
+
+    // A step decodes, at most, all the moves of each relinking, plus the
+    // candidates of the next steps in the idle slots.
+    std::size_t max_batch_size = decode_contexts.size();
+    for(std::size_t r = 0; r < ws.num_relinks; ++r)
+        max_batch_size += ws.relinks[r].remaining.size();
+    ws.batch.reserve(max_batch_size);
+
+    auto& buffers = ws.buffers;
+    const std::size_t num_buffers = materialized? max_batch_size :
+                                                  decode_contexts.size();
+    if(buffers.size() < num_buffers)
+        buffers.resize(num_buffers);
+
+    for(auto& buffer : buffers) {
+        buffer.chr.resize(chromosome_size);
+        buffer.side = 2;
+    }
+}
 
-    // Allocate memory for the candidates.
-    std::vector<Triple> candidates_left(num_blocks);
-    std::vector<Triple> candidates_right(num_blocks);
+//----------------------------------------------------------------------------//
 
-    for(auto &cand : candidates_left)
-        cand.chr.resize(chr1.size());
+template <class Decoder>
+inline bool BRKGA_MP_IPR<Decoder>::loadIprBuffer(IprCandidateBuffer& buffer,
+                                                 const std::size_t pair_index,
+                                                 const unsigned side) {
+    const auto& relink = ipr_workspace.relinks[pair_index];
+    if(buffer.pair_index == pair_index && buffer.side == side &&
+       buffer.version == relink.point_versions[side])
+        return false;
 
-    for(auto &cand : candidates_right)
-        cand.chr.resize(chr1.size());
+    buffer.chr = relink.points[side];
+    buffer.pair_index = pair_index;
+    buffer.side = side;
+    buffer.version = relink.point_versions[side];
+    return true;
+}
 
-    const Chromosome* base = &chr1;
-    const Chromosome* guide = &chr2;
-    std::vector<Triple>* candidates_base = &candidates_left;
-    std::vector<Triple>* candidates_guide = &candidates_right;
+//----------------------------------------------------------------------------//
 
-    #ifdef _OPENMP
-    #pragma omp parallel for num_threads(max_threads)
-    #endif
-    for(std::size_t i = 0; i < candidates_left.size(); ++i)
-        std::copy(begin(*base), end(*base), begin(candidates_left[i].chr));
+template <class Decoder>
+inline void BRKGA_MP_IPR<Decoder>::recordIprCandidate(
+                                        const IprBatchEntry& entry,
+                                        const unsigned slot,
+                                        const fitness_t fitness) {
+    auto& relink = ipr_workspace.relinks[entry.relink];
+    auto& candidate = entry.ahead? relink.decoded_ahead[entry.move] :
+                                   relink.moves[entry.move];
+    candidate.fitness = fitness;
+    candidate.bounded = boundReported(slot);
+    if(entry.ahead)
+        relink.decoded_ahead_steps[entry.move] = relink.iterations + 1;
+}
 
-    #ifdef _OPENMP
-    #pragma omp parallel for num_threads(max_threads)
-    #endif
-    for(std::size_t i = 0; i < candidates_right.size(); ++i)
-        std::copy(begin(*guide), end(*guide), begin(candidates_right[i].chr));
+//----------------------------------------------------------------------------//
 
-    const bool sense = optimization_sense == Sense::MAXIMIZE;
+template <class Decoder>
+bool BRKGA_MP_IPR<Decoder>::speculativeIpr() const {
+    return params.pr_speculative && !ask_tell &&
+           params.pr_neighborhood == PathRelinking::Neighborhood::FULL;
+}
 
-    std::size_t iterations = 0;
-    while(!remaining_blocks.empty()) {
-        // Set the block of keys from the guide solution for each candidate.
-        auto it_block_idx = remaining_blocks.begin();
+//----------------------------------------------------------------------------//
 
-        for(std::size_t i = 0; i < remaining_blocks.size(); ++i) {
-            const auto block_base = (*it_block_idx) * block_size;
+template <class Decoder>
+std::size_t
+BRKGA_MP_IPR<Decoder>::idleIprSlots(const std::size_t batch_size) const {
+    if(!speculativeIpr())
+        return 0;
+
+    const std::size_t num_slots = AsyncDecoder<Decoder>?
+                                  max_in_flight_decodes : max_threads;
+    return (num_slots - batch_size % num_slots) % num_slots;
+}
 
-            const auto it_key_block1 =
-                    (*candidates_base)[i].chr.begin() + block_base;
-            const auto it_key_block2 = guide->begin() + block_base;
+//----------------------------------------------------------------------------//
 
-            const auto bs = (block_base + block_size > guide->size())?
-                            guide->size() - block_base : block_size;
+template <class Decoder>
+const std::vector<std::uint8_t>&
+BRKGA_MP_IPR<Decoder>::sampleIprMoves(const std::size_t num_moves) {
+    std::size_t sample_size = num_moves;
+    switch(params.pr_neighborhood) {
+    case PathRelinking::Neighborhood::SQUARE_ROOT:
+        sample_size = std::size_t(ceil(sqrt(double(num_moves))));
+        break;
 
-            // If these keys do not affect the solution, skip them.
-            if(!dist->affectSolution(it_key_block1, it_key_block2, bs)) {
-                it_block_idx = remaining_blocks.erase(it_block_idx);
-                --i;
-                continue;
-            }
+    case PathRelinking::Neighborhood::FIXED:
+        sample_size = std::min<std::size_t>(num_moves,
+                                            params.pr_neighborhood_size);
+        break;
 
-            // Save the former keys before...
-            std::copy_n((*candidates_base)[i].chr.begin() + block_base, bs,
-                        old_keys.begin() + block_base);
+    default:
+        break;
+    }
 
-            // ... copy the keys from the guide solution.
-            std::copy_n(guide->begin() + block_base, bs,
-                        (*candidates_base)[i].chr.begin() + block_base);
+    // There are never more moves than keys, so it does not allocate memory
+    // after the first call.
+    auto& sampled = ipr_workspace.sampled;
+    sampled.reserve(chromosome_size);
+    sampled.assign(num_moves, sample_size == num_moves);
+    if(sample_size == num_moves)
+        return sampled;
 
-            (*candidates_base)[i].block_index = *it_block_idx;
-            ++it_block_idx;
+    // Selection sampling: each move is taken with probability
+    // (needed / left), so the sample keeps the order of the moves.
+    auto& rng = rng_per_thread[0];
+    std::size_t needed = sample_size;
+    for(std::size_t i = 0; i < num_moves && needed > 0; ++i) {
+        if(randInt(unsigned(num_moves - i - 1), rng) < needed) {
+            sampled[i] = 1;
+            --needed;
         }
+    }
 
-        if (remaining_blocks.empty()) {
-            break;
-        }
+    num_pr_saved_decodes += unsigned(num_moves - sample_size);
+    return sampled;
+}
 
-        // Decode the candidates.
-        volatile bool times_up = false;
-        #ifdef _OPENMP
-            #pragma omp parallel for num_threads(max_threads) shared(times_up) \
-                schedule(static, 1)
-        #endif
-        for(std::size_t i = 0; i < remaining_blocks.size(); ++i) {
-            if(sense)
-                (*candidates_base)[i].fitness = FITNESS_T_MIN;
-            else
-                (*candidates_base)[i].fitness = FITNESS_T_MAX;
+//----------------------------------------------------------------------------//
 
-            if(times_up) continue;
+template <class Decoder>
+typename BRKGA_MP_IPR<Decoder>::EliteDistanceCache&
+BRKGA_MP_IPR<Decoder>::refreshEliteDistances(const unsigned pop_a,
+                        const unsigned pop_b,
+                        const std::shared_ptr<DistanceFunctionBase>& dist) {
+    const std::size_t num_pops = params.num_independent_populations;
+    if(elite_distances.size() < num_pops * num_pops)
+        elite_distances.resize(num_pops * num_pops);
+
+    auto& cache = elite_distances[pop_a * num_pops + pop_b];
+
+    // Sizes all buffers on the first use, so that later refreshings do not
+    // allocate memory.
+    for(auto* ids : {&cache.row_ids, &cache.col_ids,
+                     &cache.old_row_ids, &cache.old_col_ids})
+        ids->reserve(elite_size);
+    cache.values.reserve(elite_size * elite_size);
+    cache.old_values.reserve(elite_size * elite_size);
+    cache.sorted_ids.reserve(elite_size);
+
+    std::swap(cache.row_ids, cache.old_row_ids);
+    std::swap(cache.col_ids, cache.old_col_ids);
+    std::swap(cache.values, cache.old_values);
+
+    cache.row_ids.resize(elite_size);
+    cache.col_ids.resize(elite_size);
+    for(std::size_t i = 0; i < elite_size; ++i) {
+        cache.row_ids[i] = fingerprint(current[pop_a]->
+                chromosomes[current[pop_a]->fitness[i].second]);
+        cache.col_ids[i] = fingerprint(current[pop_b]->
+                chromosomes[current[pop_b]->fitness[i].second]);
+    }
 
-            (*candidates_base)[i].fitness =
-                    decoder.decode((*candidates_base)[i].chr, false);
+    cache.values.assign(elite_size * elite_size,
+                        std::numeric_limits<double>::quiet_NaN());
+
+    // Hamming distances are computed on signatures. They cost about the
+    // same as the fingerprints, and turn each distance into n / 64 words.
+    const auto* hamming = exactHamming(*dist);
+    cache.num_words = hamming?
+                      HammingDistance::signatureSize(chromosome_size) : 0;
+    cache.row_signatures.resize(elite_size * cache.num_words);
+    cache.col_signatures.resize(elite_size * cache.num_words);
+    for(std::size_t i = 0; hamming && i < elite_size; ++i) {
+        hamming->signature(current[pop_a]->
+                    chromosomes[current[pop_a]->fitness[i].second],
+                cache.row_signatures.data() + i * cache.num_words);
+        hamming->signature(current[pop_b]->
+                    chromosomes[current[pop_b]->fitness[i].second],
+                cache.col_signatures.data() + i * cache.num_words);
+    }
 
-            const auto elapsed_seconds =
-                 std::chrono::duration_cast<std::chrono::seconds>
-                 (std::chrono::system_clock::now() - pr_start_time);
-            if(elapsed_seconds > max_time)
-                times_up = true;
+    // Finds the former rank of each elite individual.
+    const auto map_ranks = [&](const std::vector<std::uint64_t>& old_ids,
+                               const std::vector<std::uint64_t>& new_ids,
+                               std::vector<std::size_t>& ranks) {
+        auto& sorted = cache.sorted_ids;
+        sorted.resize(old_ids.size());
+        for(std::size_t i = 0; i < old_ids.size(); ++i)
+            sorted[i] = std::make_pair(old_ids[i], i);
+        std::sort(sorted.begin(), sorted.end());
+
+        ranks.resize(new_ids.size());
+        for(std::size_t i = 0; i < new_ids.size(); ++i) {
+            const auto it = std::lower_bound(sorted.begin(), sorted.end(),
+                                std::make_pair(new_ids[i], std::size_t(0)));
+            ranks[i] = (it != sorted.end() && it->first == new_ids[i])?
+                       it->second : std::numeric_limits<std::size_t>::max();
         }
+    };
 
-        // Locate the best candidate.
-        std::size_t best_index = 0;
-        std::size_t best_block_index = 0;
+    const auto parameters = distanceParameters(*dist);
+    const bool reuse = cache.distance == dist &&
+                       cache.distance_parameters == parameters &&
+                       cache.old_values.size() == cache.values.size();
+    if(!reuse) {
+        cache.old_row_ids.clear();
+        cache.old_col_ids.clear();
+    }
+    map_ranks(cache.old_row_ids, cache.row_ids, cache.row_map);
+    map_ranks(cache.old_col_ids, cache.col_ids, cache.col_map);
+    cache.distance = dist;
+    cache.distance_parameters = parameters;
 
-        fitness_t best_value;
-        if(sense)
-            best_value = FITNESS_T_MIN;
-        else
-            best_value = FITNESS_T_MAX;
-
-        for(std::size_t i = 0; i < remaining_blocks.size(); ++i) {
-            if((best_value < (*candidates_base)[i].fitness && sense) ||
-               (best_value > (*candidates_base)[i].fitness && !sense)) {
-                best_block_index = (*candidates_base)[i].block_index;
-                best_value = (*candidates_base)[i].fitness;
-                best_index = i;
-            }
-        }
+    if(!reuse)
+        return cache;
 
-        // Hold it, if it is the best found until now.
-        if((sense && best_found.first < (*candidates_base)[best_index].fitness)
-           ||
-           (!sense && best_found.first > (*candidates_base)[best_index].fitness)
-           ) {
-            best_found.first = (*candidates_base)[best_index].fitness;
-            std::copy(begin((*candidates_base)[best_index].chr),
-                      end((*candidates_base)[best_index].chr),
-                      begin(best_found.second));
+    for(std::size_t i = 0; i < elite_size; ++i) {
+        const auto old_i = cache.row_map[i];
+        if(old_i >= elite_size)
+            continue;
+        for(std::size_t j = 0; j < elite_size; ++j) {
+            const auto old_j = cache.col_map[j];
+            if(old_j < elite_size)
+                cache.values[i * elite_size + j] =
+                    cache.old_values[old_i * elite_size + old_j];
         }
+    }
+    return cache;
+}
 
-        // Restore original keys and copy the block of keys for all future
-        // candidates. The last candidate will not be used.
-        it_block_idx = remaining_blocks.begin();
-        for(std::size_t i = 0; i < remaining_blocks.size() - 1;
-            ++i, ++it_block_idx) {
-
-            auto block_base = (*it_block_idx) * block_size;
-            auto bs = (block_base + block_size > guide->size())?
-                      guide->size() - block_base : block_size;
-
-            std::copy_n(old_keys.begin() + block_base, bs,
-                        (*candidates_base)[i].chr.begin() + block_base);
+//----------------------------------------------------------------------------//
 
-            // Recompute the offset for the best block.
-            block_base = best_block_index * block_size;
-            bs = (block_base + block_size > guide->size())?
-                 guide->size() - block_base : block_size;
+template <class Decoder>
+double BRKGA_MP_IPR<Decoder>::eliteDistance(EliteDistanceCache& cache,
+                                            const unsigned pop_a,
+                                            const std::size_t rank_a,
+                                            const unsigned pop_b,
+                                            const std::size_t rank_b,
+                                            DistanceFunctionBase& dist) {
+    auto& value = cache.values[rank_a * elite_size + rank_b];
+    if(!std::isnan(value))
+        return value;
+
+    if(cache.num_words > 0)
+        value = double(HammingDistance::signatureDistance(
+                    cache.row_signatures.data() + rank_a * cache.num_words,
+                    cache.col_signatures.data() + rank_b * cache.num_words,
+                    cache.num_words));
+    else
+        value = dist.distance(current[pop_a]->getChromosome(rank_a),
+                              current[pop_b]->getChromosome(rank_b));
 
-            std::copy_n((*candidates_base)[best_index].chr.begin() + block_base,
-                        bs, (*candidates_base)[i].chr.begin() + block_base);
-        }
+    // Within the same population, the matrix is symmetric.
+    if(pop_a == pop_b)
+        cache.values[rank_b * elite_size + rank_a] = value;
+    return value;
+}
 
-        std::swap(base, guide);
-        std::swap(candidates_base, candidates_guide);
-        remaining_blocks.erase(best_block_index);
+//----------------------------------------------------------------------------//
 
-        const auto elapsed_seconds =
-            std::chrono::duration_cast<std::chrono::seconds>
-            (std::chrono::system_clock::now() - pr_start_time);
+template <class Decoder>
+bool BRKGA_MP_IPR<Decoder>::eliteFarEnough(EliteDistanceCache& cache,
+                                           const unsigned pop_a,
+                                           const std::size_t rank_a,
+                                           const unsigned pop_b,
+                                           const std::size_t rank_b,
+                                           DistanceFunctionBase& dist,
+                                           const double minimum_distance) {
+    const double threshold = minimum_distance - 1e-6;
+    const double value = eliteDistance(cache, pop_a, rank_a, pop_b, rank_b,
+                                       dist);
+
+    const auto* sampled = dynamic_cast<SampledKendallTauDistance*>(&dist);
+    const double error = sampled? sampled->maxError(chromosome_size) : 0.0;
+    if(value >= threshold + error)
+        return true;
+    if(value < threshold - error)
+        return false;
 
-        if((elapsed_seconds > max_time) || (iterations++ > path_size))
-            break;
-    } // end while
+    return SampledKendallTauDistance::exactDistance(
+                current[pop_a]->getChromosome(rank_a),
+                current[pop_b]->getChromosome(rank_b), threshold) >= threshold;
 }
 
 //----------------------------------------------------------------------------//
 
 template <class Decoder>
-void BRKGA_MP_IPR<Decoder>::permutatioBasedPathRelink(
-                Chromosome& chr1, Chromosome& chr2,
-                std::shared_ptr<DistanceFunctionBase> /*non-used*/,
-                std::pair<fitness_t, Chromosome>& best_found,
-                std::size_t /*non-used block_size*/,
-                std::chrono::seconds max_time,
-                double percentage) {
+std::uint64_t
+BRKGA_MP_IPR<Decoder>::fingerprint(const Chromosome& chromosome) {
+    // FNV-1a over the bits of the keys, followed by a SplitMix64 finalizer.
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto key : chromosome) {
+        hash ^= std::bit_cast<std::uint64_t>(key);
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
 
-    const std::size_t path_size = std::size_t(percentage * chromosome_size);
+//----------------------------------------------------------------------------//
 
-    std::set<std::size_t> remaining_indices;
-    for(std::size_t i = 0; i < chr1.size(); ++i)
-        remaining_indices.insert(i);
+template <class Decoder>
+std::uint64_t BRKGA_MP_IPR<Decoder>::distanceParameters(
+                                        const DistanceFunctionBase& dist) {
+    std::uint64_t words[3] {0, 0, 0};
+    if(const auto* hamming = dynamic_cast<const HammingDistance*>(&dist))
+        words[0] = std::bit_cast<std::uint64_t>(hamming->threshold);
+    else
+    if(const auto* sampled =
+            dynamic_cast<const SampledKendallTauDistance*>(&dist)) {
+        words[0] = std::bit_cast<std::uint64_t>(sampled->max_error);
+        words[1] = std::bit_cast<std::uint64_t>(sampled->failure_probability);
+        words[2] = sampled->seed;
+    }
+    else
+        return 0;
 
-    struct DecodeStruct {
-    public:
-        Chromosome chr;
-        fitness_t fitness;
-        std::size_t key_index;
-        std::size_t pos1;
-        std::size_t pos2;
-        DecodeStruct(): chr(), fitness(FITNESS_T_MAX),
-                        key_index(0), pos1(0), pos2(0) {}
-    };
+    // Same hashing as fingerprint().
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto word : words) {
+        hash ^= word;
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
 
-    // Allocate memory for the candidates.
-    std::vector<DecodeStruct> candidates_left(chr1.size());
-    std::vector<DecodeStruct> candidates_right(chr1.size());
+//----------------------------------------------------------------------------//
 
-    for(auto& cand : candidates_left)
-        cand.chr.resize(chr1.size());
+template <class Decoder>
+const HammingDistance* BRKGA_MP_IPR<Decoder>::exactHamming(
+                                        const DistanceFunctionBase& dist) {
+    return (typeid(dist) == typeid(HammingDistance))?
+           static_cast<const HammingDistance*>(&dist) : nullptr;
+}
 
-    for(auto& cand : candidates_right)
-        cand.chr.resize(chr1.size());
+//----------------------------------------------------------------------------//
 
-    Chromosome* base = &chr1;
-    Chromosome* guide = &chr2;
-    std::vector<DecodeStruct>* candidates_base = &candidates_left;
-    std::vector<DecodeStruct>* candidates_guide = &candidates_right;
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::prepareIprSignatures(
+                                        const HammingDistance& hamming,
+                                        IprRelink& relink) {
+    const auto num_words =
+        HammingDistance::signatureSize(relink.ends[0].size());
+    for(unsigned side = 0; side < 2; ++side) {
+        relink.end_signatures[side].resize(num_words);
+        hamming.signature(relink.ends[side],
+                          relink.end_signatures[side].data());
+        relink.point_signatures[side] = relink.end_signatures[side];
+    }
+}
 
-    std::vector<std::size_t> chr1_indices(chr1.size());
-    std::vector<std::size_t> chr2_indices(chr1.size());
-    std::vector<std::size_t>* base_indices = &chr1_indices;
-    std::vector<std::size_t>* guide_indices = &chr2_indices;
+//----------------------------------------------------------------------------//
 
-    // Create and order the indices.
-    std::vector<std::pair<double, std::size_t>> sorted(chr1.size());
+template <class Decoder>
+template <class Work>
+void BRKGA_MP_IPR<Decoder>::dispatchDistance(DistanceFunctionBase& dist,
+                                             Work&& work) {
+    if(typeid(dist) == typeid(HammingDistance))
+        work(static_cast<HammingDistance&>(dist));
+    else if(typeid(dist) == typeid(KendallTauDistance))
+        work(static_cast<KendallTauDistance&>(dist));
+    else
+        work(dist);
+}
 
-    for(unsigned j = 0; j < 2; ++j) {
-        for(std::size_t i = 0; i < base->size(); ++i)
-            sorted[i] = std::pair<double, std::size_t>((*base)[i], i);
+//----------------------------------------------------------------------------//
 
-        std::sort(begin(sorted), end(sorted));
-        for(std::size_t i = 0; i < base->size(); ++i)
-            (*base_indices)[i] = sorted[i].second;
+template <class Decoder>
+template <class Distance>
+bool BRKGA_MP_IPR<Decoder>::affectsSolution(Distance& dist,
+                                    Chromosome::const_iterator v1_begin,
+                                    Chromosome::const_iterator v2_begin,
+                                    const std::size_t block_size) {
+    if constexpr(std::is_same_v<Distance, DistanceFunctionBase>)
+        return dist.affectSolution(v1_begin, v2_begin, block_size);
+    else
+        return dist.Distance::affectSolution(v1_begin, v2_begin, block_size);
+}
 
-        swap(base, guide);
-        swap(base_indices, guide_indices);
-    }
+//----------------------------------------------------------------------------//
 
-    base = &chr1;
-    guide = &chr2;
-    base_indices = &chr1_indices;
-    guide_indices = &chr2_indices;
+template <class Decoder>
+template <class Prepare, class Finish>
+void BRKGA_MP_IPR<Decoder>::decodeBatch(const std::size_t num_decodes,
+        const bool rewrite, Prepare&& prepare, Finish&& finish) {
+
+    // Within an ask/tell session, hand the whole batch to the caller.
+    if(ask_tell) {
+        auto& session = *ask_tell;
+        session.chromosomes.clear();
+        session.indices.clear();
+        for(std::size_t i = 0; i < num_decodes; ++i) {
+            if(Chromosome* chromosome = prepare(i, 0)) {
+                session.chromosomes.push_back(chromosome);
+                session.indices.push_back(i);
+            }
+        }
 
-    #ifdef _OPENMP
-    #pragma omp parallel for num_threads(max_threads)
-    #endif
-    for(std::size_t i = 0; i < candidates_left.size(); ++i) {
-        std::copy(begin(*base), end(*base), begin(candidates_left[i].chr));
-    }
+        if(session.chromosomes.empty())
+            return;
 
-    #ifdef _OPENMP
-    #pragma omp parallel for num_threads(max_threads)
-    #endif
-    for(std::size_t i = 0; i < candidates_right.size(); ++i) {
-        std::copy(begin(*guide), end(*guide), begin(candidates_right[i].chr));
+        session.publish(rewrite);
+        num_batch_decodes += session.indices.size();
+        for(std::size_t k = 0; k < session.indices.size(); ++k)
+            finish(session.indices[k], 0, session.fitness[k]);
+        return;
     }
 
-    const bool sense = optimization_sense == Sense::MAXIMIZE;
+    if constexpr(AsyncDecoder<Decoder>) {
+        const unsigned max_in_flight = max_in_flight_decodes;
+        std::vector<std::future<fitness_t>> pending(max_in_flight);
+        std::vector<std::size_t> decode_per_slot(max_in_flight);
+
+        // Slot 0 is the first to be used.
+        std::vector<unsigned> free_slots(max_in_flight);
+        std::iota(free_slots.rbegin(), free_slots.rend(), 0u);
+
+        std::size_t next = 0;
+        try {
+            while(next < num_decodes ||
+                  free_slots.size() < max_in_flight) {
+
+                // Launch as many decodings as the limit allows.
+                while(next < num_decodes && !free_slots.empty()) {
+                    const auto slot = free_slots.back();
+                    if(Chromosome* chromosome = prepare(next, slot)) {
+                        if constexpr(ContextAwareDecoder<Decoder>) {
+                            // Share the budget among the decodings in
+                            // flight and those that will start soon.
+                            const std::size_t concurrency = std::min<
+                                std::size_t>(max_in_flight,
+                                    max_in_flight - free_slots.size() +
+                                    num_decodes - next);
+                            auto& context = decode_contexts[slot];
+                            context.num_threads = std::max<unsigned>(1,
+                                decode_thread_budget / unsigned(concurrency));
+                            pending[slot] = decoder.decodeAsync(*chromosome,
+                                                                rewrite,
+                                                                context);
+                        }
+                        else
+                            pending[slot] = decoder.decodeAsync(*chromosome,
+                                                                rewrite);
+                        decode_per_slot[slot] = next;
+                        free_slots.pop_back();
+                        ++num_batch_decodes;
+                    }
+                    ++next;
+                }
 
-    std::size_t iterations = 0;
-    while(!remaining_indices.empty()) {
-        std::size_t position_in_base;
-        std::size_t position_in_guide;
+                // Collect the results ready so far. If none is ready, wait a
+                // little for the first pending one, and poll again.
+                bool collected = false;
+                while(!collected && free_slots.size() < max_in_flight) {
+                    unsigned first_pending = max_in_flight;
+                    for(unsigned slot = 0; slot < max_in_flight; ++slot) {
+                        auto& result = pending[slot];
+                        if(!result.valid())
+                            continue;
+
+                        if(result.wait_for(std::chrono::seconds::zero()) !=
+                           std::future_status::ready) {
+                            if(first_pending == max_in_flight)
+                                first_pending = slot;
+                            continue;
+                        }
+
+                        const auto fitness = result.get();
+                        free_slots.push_back(slot);
+                        recordBound(slot);
+                        finish(decode_per_slot[slot], slot, fitness);
+                        collected = true;
+                    }
 
-        auto it_idx = remaining_indices.begin();
-        for(std::size_t i = 0; i < remaining_indices.size(); ++i) {
-            position_in_base = (*base_indices)[*it_idx];
-            position_in_guide = (*guide_indices)[*it_idx];
+                    if(!collected)
+                        pending[first_pending].wait_for(
+                            std::chrono::microseconds(50));
+                }
+            }
+        }
+        catch(...) {
+            // The chromosomes must outlive the pending decodings.
+            for(auto& result : pending)
+                if(result.valid())
+                    result.wait();
+            throw;
+        }
+    }
+    else {
+        // Used to share the thread budget among the decodings.
+        [[maybe_unused]] std::atomic<std::size_t> num_started {0};
+        [[maybe_unused]] std::atomic<std::size_t> num_running {0};
+        std::size_t num_decoded = 0;
 
-            if(position_in_base == position_in_guide) {
-                it_idx = remaining_indices.erase(it_idx);
-                --i;
+        #ifdef _OPENMP
+            #pragma omp parallel for num_threads(max_threads) \
+                schedule(static, 1) if(num_decodes > 1) \
+                reduction(+: num_decoded)
+        #endif
+        for(std::size_t i = 0; i < num_decodes; ++i) {
+            #ifdef _OPENMP
+                const unsigned slot = omp_get_thread_num();
+            #else
+                const unsigned slot = 0;
+            #endif
+
+            Chromosome* chromosome = prepare(i, slot);
+            if(chromosome == nullptr)
                 continue;
-            }
+            ++num_decoded;
 
-            (*candidates_base)[i].key_index = *it_idx;
-            (*candidates_base)[i].pos1 = position_in_base;
-            (*candidates_base)[i].pos2 = position_in_guide;
+            if constexpr(ContextAwareDecoder<Decoder>) {
+                auto& context = decode_contexts[slot];
 
-            if(sense)
-                (*candidates_base)[i].fitness = FITNESS_T_MIN;
+                // Share the budget among the decodings running now and
+                // those that will start soon.
+                #ifdef _OPENMP
+                    const std::size_t team_size = omp_get_num_threads();
+                #else
+                    const std::size_t team_size = 1;
+                #endif
+                const auto running = ++num_running;
+                const auto not_started = num_decodes - ++num_started;
+                const auto concurrency =
+                    std::min(team_size, running + not_started);
+                context.num_threads = std::max<unsigned>(1,
+                    decode_thread_budget / unsigned(concurrency));
+
+                const auto fitness = decoder.decode(*chromosome, rewrite,
+                                                    context);
+                --num_running;
+
+                recordBound(slot);
+                finish(i, slot, fitness);
+            }
             else
-                (*candidates_base)[i].fitness = FITNESS_T_MAX;
-            ++it_idx;
+                finish(i, slot, decoder.decode(*chromosome, rewrite));
         }
+        num_batch_decodes += num_decoded;
+    }
+}
 
-        if(remaining_indices.size() == 0)
-            break;
-
-        // Decode the candidates.
-        volatile bool times_up = false;
-        #ifdef _OPENMP
-            #pragma omp parallel for num_threads(max_threads) shared(times_up) \
-                schedule(static, 1)
-        #endif
-        for(std::size_t i = 0; i < remaining_indices.size(); ++i) {
-            if(times_up) continue;
-
-            std::swap((*candidates_base)[i].chr[(*candidates_base)[i].pos1],
-                      (*candidates_base)[i].chr[(*candidates_base)[i].pos2]);
+//----------------------------------------------------------------------------//
 
-            (*candidates_base)[i].fitness =
-                    decoder.decode((*candidates_base)[i].chr, false);
+template <class Decoder>
+inline Chromosome* BRKGA_MP_IPR<Decoder>::bindChromosome(
+        Chromosome& chromosome, const unsigned slot) {
+    if constexpr(ContextAwareDecoder<Decoder>) {
+        auto& context = decode_contexts[slot];
+        context.setChromosome(chromosome);
+        context.requested_fidelity = decode_fidelity;
+        context.cutoff_set = use_decode_cutoff;
+        context.cutoff_value = decode_cutoff;
+    }
+    return &chromosome;
+}
 
-            std::swap((*candidates_base)[i].chr[(*candidates_base)[i].pos1],
-                      (*candidates_base)[i].chr[(*candidates_base)[i].pos2]);
+//----------------------------------------------------------------------------//
 
-            const auto elapsed_seconds =
-                    std::chrono::duration_cast<std::chrono::seconds>
-                    (std::chrono::system_clock::now() - pr_start_time);
-            if(elapsed_seconds > max_time)
-                times_up = true;
+template <class Decoder>
+inline Chromosome* BRKGA_MP_IPR<Decoder>::bindIndividual(
+        Population& population, const unsigned chr_idx, const unsigned slot,
+        const Population* parents) {
+    auto& chromosome = population.chromosomes[chr_idx];
+    population.approximate_fitness[chr_idx] =
+        (decode_fidelity == DecodeFidelity::LOW)?
+        Population::LOW_FIDELITY_FITNESS : Population::EXACT_FITNESS;
+    population.payloads[chr_idx].reset();
+
+    if constexpr(ContextAwareDecoder<Decoder>) {
+        auto& context = decode_contexts[slot];
+
+        population.key_order_valid[chr_idx] = 0;
+        context.setChromosome(chromosome, &population.key_orders[chr_idx],
+                              &population.key_order_valid[chr_idx]);
+        context.requested_fidelity = decode_fidelity;
+        context.cutoff_set = use_decode_cutoff;
+        context.cutoff_value = decode_cutoff;
+        context.fitness_flag = &population.approximate_fitness[chr_idx];
+        context.payload = &population.payloads[chr_idx];
+
+        if(parents != nullptr) {
+            const auto parent = offspring_dominant_parent[chr_idx];
+            if(parent < parents->key_order_valid.size() &&
+               parents->key_order_valid[parent] != 0)
+                context.setParentHint(parents->key_orders[parent],
+                                      offspring_foreign_positions[chr_idx]);
         }
+    }
+    return &chromosome;
+}
 
-        // Locate the best candidate
-        std::size_t best_key_index = 0;
-        std::size_t best_index = 0;
-
-        fitness_t best_value;
-        best_value = sense? FITNESS_T_MIN : FITNESS_T_MAX;
+//----------------------------------------------------------------------------//
 
-        for(std::size_t i = 0; i < remaining_indices.size(); ++i) {
-            if((best_value < (*candidates_base)[i].fitness && sense) ||
-               (best_value > (*candidates_base)[i].fitness && !sense)) {
-                best_index = i;
-                best_key_index = (*candidates_base)[i].key_index;
-                best_value = (*candidates_base)[i].fitness;
+template <class Decoder>
+inline fitness_t BRKGA_MP_IPR<Decoder>::decodeChromosome(
+        Chromosome& chromosome, const bool rewrite,
+        std::shared_ptr<const std::any>* payload) {
+    // Single decodings are always exact and complete.
+    const auto previous_fidelity = decode_fidelity;
+    const auto previous_use_cutoff = use_decode_cutoff;
+    decode_fidelity = DecodeFidelity::HIGH;
+    use_decode_cutoff = false;
+
+    fitness_t value {};
+    decodeBatch(1, rewrite,
+        [&](const std::size_t /*not-used*/, const unsigned slot) {
+            return bindChromosome(chromosome, slot);
+        },
+        [&](const std::size_t /*not-used*/, const unsigned slot,
+            const fitness_t fitness) {
+            value = fitness;
+            if constexpr(ContextAwareDecoder<Decoder>) {
+                if(payload != nullptr)
+                    *payload = std::move(decode_contexts[slot].local_payload);
             }
         }
+    );
 
-        position_in_base = (*base_indices)[best_key_index];
-        position_in_guide = (*guide_indices)[best_key_index];
+    decode_fidelity = previous_fidelity;
+    use_decode_cutoff = previous_use_cutoff;
+    return value;
+}
 
-        // Commit the best exchange in all candidates.
-        // The last will not be used.
-        for(std::size_t i = 0; i < remaining_indices.size() - 1; ++i) {
-            std::swap((*candidates_base)[i].chr[position_in_base],
-                      (*candidates_base)[i].chr[position_in_guide]);
-        }
+//----------------------------------------------------------------------------//
 
-        std::swap((*base_indices)[position_in_base],
-                  (*base_indices)[position_in_guide]);
+template <class Decoder>
+inline bool BRKGA_MP_IPR<Decoder>::boundReported(const unsigned slot) const {
+    if constexpr(ContextAwareDecoder<Decoder>)
+        return decode_contexts[slot].cutoff_set &&
+               decode_contexts[slot].bound_reported;
+    else
+        return false;
+}
 
-        // Hold, if it is the best found until now
-        if((sense && best_found.first < best_value) ||
-           (!sense && best_found.first > best_value)) {
-            const auto& best_chr = (*candidates_base)[best_index].chr;
-            best_found.first = best_value;
-            copy(begin(best_chr), end(best_chr), begin(best_found.second));
-        }
+//----------------------------------------------------------------------------//
 
-        std::swap(base_indices, guide_indices);
-        std::swap(candidates_base, candidates_guide);
-        remaining_indices.erase(best_key_index);
+template <class Decoder>
+inline void BRKGA_MP_IPR<Decoder>::recordBound(const unsigned slot) {
+    if(!boundReported(slot))
+        return;
 
-        // Is time to stop?
-        const auto elapsed_seconds =
-            std::chrono::duration_cast<std::chrono::seconds>
-            (std::chrono::system_clock::now() - pr_start_time);
+    auto& context = decode_contexts[slot];
+    if(context.fitness_flag != nullptr)
+        *context.fitness_flag = Population::BOUNDED_FITNESS;
+    #ifdef _OPENMP
+        #pragma omp atomic
+    #endif
+    ++num_bounded_decodes;
+}
 
-        if((elapsed_seconds > max_time) || (iterations++ > path_size))
-            break;
-    }
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void BRKGA_MP_IPR<Decoder>::decodePopulation(Population& population,
+        const unsigned first, const unsigned last, const Population* parents) {
+    decodeBatch(last - first, true,
+        [&](const std::size_t i, const unsigned slot) {
+            return bindIndividual(population, first + i, slot, parents);
+        },
+        [&](const std::size_t i, const unsigned /*not-used*/,
+            const fitness_t fitness) {
+            population.setFitness(first + i, fitness);
+        }
+    );
 }
 
 //----------------------------------------------------------------------------//
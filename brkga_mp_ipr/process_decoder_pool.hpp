@@ -0,0 +1,738 @@
+/*******************************************************************************
+ * process_decoder_pool.hpp: Runs a decoder in a pool of worker processes.
+ *
+ * (c) Copyright 2015-2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ * Created on : Oct 18, 2026 by ceandrade.
+ * Last update: Oct 18, 2026 by ceandrade.
+ *
+ * This code is released under BRKGA-MP-IPR License:
+ * https://github.com/ceandrade/brkga_mp_ipr_cpp/blob/master/LICENSE.md
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef BRKGA_MP_IPR_PROCESS_DECODER_POOL_HPP_
+#define BRKGA_MP_IPR_PROCESS_DECODER_POOL_HPP_
+
+#include "fitness_type.hpp"
+#include "chromosome.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <semaphore.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+    #include <sys/prctl.h>
+#endif
+
+namespace BRKGA {
+
+/**
+ * \brief Runs a decoder in a pool of worker processes (POSIX only).
+ *
+ * This is a decoder adaptor for decoders that are not thread-safe, for
+ * instance, those wrapping non-reentrant libraries. At construction, the pool
+ * forks a spawner process, which in turn forks `num_workers` worker
+ * processes. Each worker holds its own copy of the decoder, taken from the
+ * decoder given to the constructor. Each worker has a shared-memory mailbox
+ * holding the keys of one chromosome, the `rewrite` flag, and the resulting
+ * fitness, guarded by two process-shared semaphores.
+ *
+ * The pool implements `decode(Chromosome&, bool)` and can be safely called
+ * from several threads at once. Therefore, it can be used in place of the
+ * decoder as is:
+ * \code{.cpp}
+ * MyLegacyDecoder decoder(instance);
+ * ProcessDecoderPool<MyLegacyDecoder> pool(decoder, chromosome_size, 8);
+ * BRKGA_MP_IPR<ProcessDecoderPool<MyLegacyDecoder>> algorithm(
+ *     pool, sense, seed, chromosome_size, params, 8);
+ * \endcode
+ * Each call takes a free worker, or waits for one. So, use as many threads
+ * as workers. The calling threads just sleep while the workers decode.
+ *
+ * If a worker dies while decoding (for instance, by a segmentation fault),
+ * it is restarted from the original decoder, and the chromosome is sent
+ * again. If the same chromosome kills the worker more than `max_retries`
+ * times, decode() throws. Other workers are not affected. Exceptions thrown
+ * by the decoder do not kill the worker: decode() throws a
+ * `std::runtime_error` with the same message in the caller.
+ *
+ * Workers are forked only by the spawner, which is single-threaded and does
+ * nothing else. So, restarting a worker while other threads are decoding
+ * (and maybe holding locks of the OpenMP runtime, the iostreams, or the
+ * decoder) is safe: the new worker does not inherit such locks.
+ *
+ * \warning The spawner is forked from the calling process at construction.
+ *          Build the pool before starting other threads, e.g., before the
+ *          algorithm runs any parallel code, so that the spawner does not
+ *          inherit locks held by them. Since all workers are copies of the
+ *          spawner, changes of the decoder state after the pool is built
+ *          are not seen by them. Also, fitness_t must not hold pointers,
+ *          since its value is copied through the shared memory.
+ */
+template <class Decoder>
+class ProcessDecoderPool {
+public:
+    /** \name Constructors and destructor */
+    ///@{
+    /**
+     * \brief Builds the pool and forks the workers.
+     *
+     * \param decoder the decoder to be copied into the workers.
+     * \param chromosome_size the size of the chromosomes.
+     * \param num_workers the number of worker processes.
+     * \param max_retries the number of times a chromosome is re-sent after
+     *        its worker dies.
+     * \throws std::range_error if `num_workers` is zero.
+     * \throws std::runtime_error if the shared memory or the workers cannot
+     *         be created.
+     */
+    ProcessDecoderPool(Decoder& decoder, unsigned chromosome_size,
+                       unsigned num_workers, unsigned max_retries = 2);
+
+    /// Stops all workers and releases the shared memory.
+    ~ProcessDecoderPool();
+
+    ProcessDecoderPool(const ProcessDecoderPool&) = delete;
+    ProcessDecoderPool& operator=(const ProcessDecoderPool&) = delete;
+    ///@}
+
+    /** \name Decoding */
+    ///@{
+    /**
+     * \brief Decodes the chromosome in one of the workers.
+     *
+     * If `rewrite` is true, the keys modified by the worker are copied back
+     * into `chromosome`.
+     *
+     * \param chromosome the chromosome to be decoded.
+     * \param rewrite indicates whether the decoder may rewrite the chromosome.
+     * \returns the fitness of the chromosome.
+     * \throws std::range_error if the chromosome size differs from the one
+     *         given in the constructor.
+     * \throws std::runtime_error if the decoder throws, if the chromosome
+     *         kills its worker more than `max_retries` times, or if a worker
+     *         cannot be restarted.
+     */
+    fitness_t decode(Chromosome& chromosome, bool rewrite);
+    ///@}
+
+    /** \name Getters */
+    ///@{
+    unsigned getNumWorkers() const { return workers.size(); }
+
+    /// Returns the number of workers restarted after dying.
+    unsigned getNumRestarts() const { return num_restarts; }
+    ///@}
+
+protected:
+    /// Mailbox of one worker, at the beginning of its shared memory.
+    struct Mailbox {
+        /// Posted by the pool when there is a chromosome to decode.
+        sem_t request {};
+
+        /// Posted by the worker when the fitness is ready.
+        sem_t response {};
+
+        /// If true, the worker must exit.
+        bool stop {false};
+
+        /// Indicates whether the decoder may rewrite the chromosome.
+        bool rewrite {false};
+
+        /// The decoded fitness.
+        fitness_t fitness {};
+
+        /// Indicates whether the decoder threw, and its message.
+        bool failed {false};
+        char error[256] {};
+
+        /// Set by the spawner once the worker process is gone.
+        std::atomic<bool> exited {false};
+    };
+
+    /// Mailbox of the spawner process.
+    struct SpawnerMailbox {
+        /// Posted by the pool when a worker must be started.
+        sem_t request {};
+
+        /// Posted by the spawner once the worker is started.
+        sem_t response {};
+
+        /// If true, the spawner must stop the workers and exit.
+        bool stop {false};
+
+        /// The worker to be started.
+        unsigned worker_index {0};
+
+        /// Indicates whether the worker could not be forked.
+        bool failed {false};
+    };
+
+    /// A worker process and its shared memory.
+    struct Worker {
+        /// Indicates whether the worker was started.
+        bool running {false};
+
+        /// The shared memory.
+        void* memory {nullptr};
+
+        /// The mailbox.
+        Mailbox* mailbox {nullptr};
+
+        /// The chromosome keys, right after the mailbox.
+        double* keys {nullptr};
+
+        /// Indicates whether the mailbox semaphores were initialized.
+        bool semaphores_initialized {false};
+    };
+
+    static_assert(std::atomic<bool>::is_always_lock_free,
+                  "Process-shared flags need lock-free atomics");
+
+    /** \name Worker management */
+    ///@{
+    /// Forks the spawner process.
+    void startSpawner();
+
+    /// Initializes the mailbox and asks the spawner to fork the worker.
+    void startWorker(unsigned worker_index);
+
+    /// Stops all workers and the spawner, and releases the shared memory.
+    void release();
+
+    /**
+     * \brief Main loop of the spawner process: forks the workers on demand,
+     * and reports the ones that exit. Never returns.
+     */
+    [[noreturn]] void spawnerLoop();
+
+    /// Main loop of the worker process. Never returns.
+    [[noreturn]] void workerLoop(Worker& worker);
+
+    /**
+     * \brief Waits for the response of the worker.
+     * \returns false if the worker died meanwhile.
+     */
+    bool waitResponse(Worker& worker);
+
+    /**
+     * \brief Waits up to 10ms for the semaphore.
+     * \returns true if the semaphore was taken.
+     * \throws std::runtime_error if the wait fails.
+     */
+    static bool waitBriefly(sem_t& semaphore);
+
+    /// Returns true if the spawner process is still running.
+    bool spawnerAlive();
+    ///@}
+
+protected:
+    /// The decoder copied into the workers.
+    Decoder& decoder;
+
+    /// Size of the chromosomes.
+    const unsigned chromosome_size;
+
+    /// Number of retries after a worker dies.
+    const unsigned max_retries;
+
+    /// Size of the shared memory of each worker.
+    const std::size_t memory_size;
+
+    /// The workers.
+    std::vector<Worker> workers;
+
+    /// Indices of the workers not in use.
+    std::vector<unsigned> free_workers;
+
+    /// Guards `free_workers`.
+    std::mutex free_workers_mutex;
+
+    /// Signals that a worker is free.
+    std::condition_variable free_worker_available;
+
+    /// Number of workers restarted after dying.
+    std::atomic<unsigned> num_restarts;
+
+    /// The spawner mailbox, in shared memory.
+    SpawnerMailbox* spawner;
+
+    /// Process id of the spawner, and whether it is still running.
+    pid_t spawner_pid;
+    std::atomic<bool> spawner_running;
+
+    /// Guards the requests to the spawner.
+    std::mutex spawner_mutex;
+};
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+ProcessDecoderPool<Decoder>::ProcessDecoderPool(Decoder& _decoder,
+        const unsigned _chromosome_size, const unsigned num_workers,
+        const unsigned _max_retries):
+    decoder(_decoder),
+    chromosome_size(_chromosome_size),
+    max_retries(_max_retries),
+    // Keys start at a cache line boundary after the mailbox.
+    memory_size(((sizeof(Mailbox) + 63) / 64) * 64 +
+                sizeof(double) * _chromosome_size),
+    workers(num_workers),
+    free_workers(),
+    free_workers_mutex(),
+    free_worker_available(),
+    num_restarts {0},
+    spawner {nullptr},
+    spawner_pid {-1},
+    spawner_running {false},
+    spawner_mutex()
+{
+    if(num_workers == 0) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "The number of workers must be positive.";
+        throw std::range_error(ss.str());
+    }
+
+    for(auto& worker : workers) {
+        worker.memory = mmap(nullptr, memory_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if(worker.memory == MAP_FAILED) {
+            worker.memory = nullptr;
+            release();
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "Cannot allocate shared memory.";
+            throw std::runtime_error(ss.str());
+        }
+
+        worker.mailbox = new(worker.memory) Mailbox {};
+        worker.keys = reinterpret_cast<double*>(
+            static_cast<char*>(worker.memory) + memory_size -
+            sizeof(double) * chromosome_size);
+    }
+
+    try {
+        startSpawner();
+        for(unsigned i = 0; i < workers.size(); ++i) {
+            startWorker(i);
+            free_workers.push_back(i);
+        }
+    }
+    catch(...) {
+        release();
+        throw;
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+ProcessDecoderPool<Decoder>::~ProcessDecoderPool() {
+    release();
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void ProcessDecoderPool<Decoder>::release() {
+    for(auto& worker : workers) {
+        if(worker.running) {
+            worker.mailbox->stop = true;
+            sem_post(&worker.mailbox->request);
+            worker.running = false;
+        }
+    }
+
+    // The spawner waits for the workers before exiting.
+    if(spawner_running) {
+        spawner->stop = true;
+        sem_post(&spawner->request);
+        while(waitpid(spawner_pid, nullptr, 0) < 0 && errno == EINTR);
+        spawner_running = false;
+    }
+
+    if(spawner != nullptr) {
+        sem_destroy(&spawner->request);
+        sem_destroy(&spawner->response);
+        spawner->~SpawnerMailbox();
+        munmap(spawner, sizeof(SpawnerMailbox));
+        spawner = nullptr;
+    }
+
+    for(auto& worker : workers) {
+        if(worker.memory != nullptr) {
+            if(worker.semaphores_initialized) {
+                sem_destroy(&worker.mailbox->request);
+                sem_destroy(&worker.mailbox->response);
+                worker.semaphores_initialized = false;
+            }
+            worker.mailbox->~Mailbox();
+            munmap(worker.memory, memory_size);
+            worker.memory = nullptr;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void ProcessDecoderPool<Decoder>::startSpawner() {
+    void* memory = mmap(nullptr, sizeof(SpawnerMailbox),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                        -1, 0);
+    if(memory == MAP_FAILED) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Cannot allocate shared memory.";
+        throw std::runtime_error(ss.str());
+    }
+
+    spawner = new(memory) SpawnerMailbox {};
+    if(sem_init(&spawner->request, 1, 0) != 0 ||
+       sem_init(&spawner->response, 1, 0) != 0) {
+        spawner->~SpawnerMailbox();
+        munmap(memory, sizeof(SpawnerMailbox));
+        spawner = nullptr;
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Cannot create process-shared semaphores.";
+        throw std::runtime_error(ss.str());
+    }
+
+    const pid_t pid = fork();
+    if(pid < 0) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Cannot fork the spawner process.";
+        throw std::runtime_error(ss.str());
+    }
+
+    if(pid == 0)
+        spawnerLoop();
+
+    spawner_pid = pid;
+    spawner_running = true;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void ProcessDecoderPool<Decoder>::startWorker(const unsigned worker_index) {
+    auto& worker = workers[worker_index];
+    auto& mailbox = *worker.mailbox;
+    mailbox.stop = false;
+    mailbox.failed = false;
+    mailbox.exited = false;
+
+    // Semaphores left by a dead worker may be in any state.
+    if(worker.semaphores_initialized) {
+        sem_destroy(&mailbox.request);
+        sem_destroy(&mailbox.response);
+        worker.semaphores_initialized = false;
+    }
+    if(sem_init(&mailbox.request, 1, 0) != 0 ||
+       sem_init(&mailbox.response, 1, 0) != 0) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Cannot create process-shared semaphores.";
+        throw std::runtime_error(ss.str());
+    }
+    worker.semaphores_initialized = true;
+
+    std::lock_guard<std::mutex> lock(spawner_mutex);
+    spawner->worker_index = worker_index;
+    sem_post(&spawner->request);
+
+    while(!waitBriefly(spawner->response)) {
+        if(!spawnerAlive()) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "The spawner process died.";
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    if(spawner->failed) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Cannot fork a worker process.";
+        throw std::runtime_error(ss.str());
+    }
+    worker.running = true;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void ProcessDecoderPool<Decoder>::spawnerLoop() {
+    #ifdef __linux__
+        // Do not outlive the main process.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if(getppid() == 1)
+            _exit(0);
+    #endif
+
+    auto& mailbox = *spawner;
+    std::vector<pid_t> pids(workers.size(), -1);
+
+    for(;;) {
+        bool requested = false;
+        try {
+            requested = waitBriefly(mailbox.request);
+        }
+        catch(...) {
+            _exit(EXIT_FAILURE);
+        }
+
+        // Report the workers that are gone.
+        pid_t pid;
+        while((pid = waitpid(-1, nullptr, WNOHANG)) > 0) {
+            const auto it = std::find(pids.begin(), pids.end(), pid);
+            if(it != pids.end()) {
+                workers[it - pids.begin()].mailbox->exited = true;
+                *it = -1;
+            }
+        }
+
+        if(!requested)
+            continue;
+        if(mailbox.stop)
+            break;
+
+        // The index may change once the response is posted.
+        const unsigned worker_index = mailbox.worker_index;
+        pid = fork();
+        if(pid == 0)
+            workerLoop(workers[worker_index]);
+
+        pids[worker_index] = pid;
+        mailbox.failed = pid < 0;
+        sem_post(&mailbox.response);
+    }
+
+    // The workers were asked to stop already.
+    while(waitpid(-1, nullptr, 0) > 0 || errno == EINTR);
+
+    // Do not run the destructors and exit handlers of the main process.
+    _exit(0);
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+void ProcessDecoderPool<Decoder>::workerLoop(Worker& worker) {
+    #ifdef __linux__
+        // Do not outlive the spawner.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if(getppid() == 1)
+            _exit(0);
+    #endif
+
+    auto& mailbox = *worker.mailbox;
+    Chromosome chromosome(chromosome_size);
+
+    for(;;) {
+        while(sem_wait(&mailbox.request) != 0 && errno == EINTR);
+        if(mailbox.stop)
+            break;
+
+        std::copy_n(worker.keys, chromosome_size, chromosome.begin());
+        mailbox.failed = false;
+        try {
+            mailbox.fitness = decoder.decode(chromosome, mailbox.rewrite);
+        }
+        catch(const std::exception& e) {
+            mailbox.failed = true;
+            std::strncpy(mailbox.error, e.what(), sizeof(mailbox.error) - 1);
+            mailbox.error[sizeof(mailbox.error) - 1] = '\0';
+        }
+        catch(...) {
+            mailbox.failed = true;
+            std::strncpy(mailbox.error, "unknown exception",
+                         sizeof(mailbox.error) - 1);
+            mailbox.error[sizeof(mailbox.error) - 1] = '\0';
+        }
+        if(mailbox.rewrite && !mailbox.failed)
+            std::copy_n(chromosome.begin(), chromosome_size, worker.keys);
+
+        sem_post(&mailbox.response);
+    }
+
+    // Do not run the destructors and exit handlers of the main process.
+    _exit(0);
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+bool ProcessDecoderPool<Decoder>::waitBriefly(sem_t& semaphore) {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += 10'000'000; // 10ms
+    if(deadline.tv_nsec >= 1'000'000'000) {
+        deadline.tv_nsec -= 1'000'000'000;
+        ++deadline.tv_sec;
+    }
+
+    if(sem_timedwait(&semaphore, &deadline) == 0)
+        return true;
+
+    if(errno != ETIMEDOUT && errno != EINTR) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Failed to wait for a process.";
+        throw std::runtime_error(ss.str());
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+bool ProcessDecoderPool<Decoder>::spawnerAlive() {
+    // Several threads may ask at once. Only one reaps the spawner, and the
+    // others see ECHILD.
+    if(spawner_running) {
+        const pid_t pid = waitpid(spawner_pid, nullptr, WNOHANG);
+        if(pid == spawner_pid || (pid < 0 && errno == ECHILD))
+            spawner_running = false;
+    }
+    return spawner_running;
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+bool ProcessDecoderPool<Decoder>::waitResponse(Worker& worker) {
+    for(;;) {
+        if(waitBriefly(worker.mailbox->response))
+            return true;
+
+        // Check whether the worker is still alive.
+        if(worker.mailbox->exited) {
+            worker.running = false;
+            // It may have answered right before dying.
+            return sem_trywait(&worker.mailbox->response) == 0;
+        }
+
+        // Without the spawner, the workers are gone, and nobody reports it.
+        if(!spawnerAlive()) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "The spawner process died.";
+            throw std::runtime_error(ss.str());
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+
+template <class Decoder>
+fitness_t ProcessDecoderPool<Decoder>::decode(Chromosome& chromosome,
+                                              const bool rewrite) {
+    if(chromosome.size() != chromosome_size) {
+        std::stringstream ss;
+        ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+           << "Chromosome size " << chromosome.size()
+           << " differs from the pool chromosome size " << chromosome_size;
+        throw std::range_error(ss.str());
+    }
+
+    unsigned worker_idx;
+    {
+        std::unique_lock<std::mutex> lock(free_workers_mutex);
+        free_worker_available.wait(lock, [&] {
+            return !free_workers.empty();
+        });
+        worker_idx = free_workers.back();
+        free_workers.pop_back();
+    }
+
+    auto release_worker = [&] {
+        {
+            std::lock_guard<std::mutex> lock(free_workers_mutex);
+            free_workers.push_back(worker_idx);
+        }
+        free_worker_available.notify_one();
+    };
+
+    auto& worker = workers[worker_idx];
+    auto& mailbox = *worker.mailbox;
+
+    try {
+        for(unsigned attempt = 0; ; ++attempt) {
+            // The worker may have died after its last response.
+            if(!worker.running || mailbox.exited) {
+                startWorker(worker_idx);
+                ++num_restarts;
+            }
+
+            std::copy_n(chromosome.begin(), chromosome_size, worker.keys);
+            mailbox.rewrite = rewrite;
+            sem_post(&mailbox.request);
+
+            if(waitResponse(worker))
+                break;
+
+            if(attempt == max_retries) {
+                std::stringstream ss;
+                ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+                   << "The chromosome killed its worker process "
+                   << (max_retries + 1) << " times.";
+                throw std::runtime_error(ss.str());
+            }
+        }
+
+        if(mailbox.failed) {
+            std::stringstream ss;
+            ss << __PRETTY_FUNCTION__ << ", line " << __LINE__ << ": "
+               << "The decoder threw in a worker process: " << mailbox.error;
+            throw std::runtime_error(ss.str());
+        }
+    }
+    catch(...) {
+        release_worker();
+        throw;
+    }
+
+    const fitness_t fitness = mailbox.fitness;
+    if(rewrite)
+        std::copy_n(worker.keys, chromosome_size, chromosome.begin());
+
+    release_worker();
+    return fitness;
+}
+
+} // end namespace BRKGA
+
+#endif // BRKGA_MP_IPR_PROCESS_DECODER_POOL_HPP_
@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * argsort.hpp: Argsort kernel for random-key chromosomes.
+ *
+ * (c) Copyright 2015-2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ * Created on : Oct 18, 2026 by ceandrade.
+ * Last update: Oct 18, 2026 by ceandrade.
+ *
+ * This code is released under BRKGA-MP-IPR License:
+ * https://github.com/ceandrade/brkga_mp_ipr_cpp/blob/master/LICENSE.md
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef BRKGA_MP_IPR_ARGSORT_HPP_
+#define BRKGA_MP_IPR_ARGSORT_HPP_
+
+#include "chromosome.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace BRKGA {
+
+/**
+ * \brief Scratch memory used by argsort().
+ *
+ * Most decoders sort the chromosome keys once per decoding. Keeping one
+ * workspace per thread (as done with any other pre-allocated decoder buffer)
+ * makes argsort() allocation-free after the first call.
+ */
+class ArgSortWorkspace {
+public:
+    /**
+     * \brief Up to this size, argsort() uses an insertion sort.
+     *
+     * For such small arrays, the counting passes of the radix sort cost
+     * more than the quadratic behavior of the insertion sort.
+     */
+    static constexpr std::size_t SMALL_SIZE = 64;
+
+    /**
+     * \brief Up to this size, argsort() uses 8-bit digits (8 passes).
+     * Beyond that, it uses 11-bit digits (6 passes), whose larger
+     * histograms pay off only for larger arrays.
+     */
+    static constexpr std::size_t MEDIUM_SIZE = 2048;
+
+    /// Default constructor.
+    ArgSortWorkspace() = default;
+
+    /// Pre-allocates memory for chromosomes up to the given size.
+    explicit ArgSortWorkspace(const std::size_t size) {
+        reserve(size);
+    }
+
+    /// Pre-allocates memory for chromosomes up to the given size.
+    void reserve(const std::size_t size) {
+        keys.reserve(size);
+        keys_buffer.reserve(size);
+        indices_buffer.reserve(size);
+    }
+
+public:
+    /// Keys mapped to unsigned integers (order-preserving).
+    std::vector<std::uint64_t> keys {};
+
+    /// Ping-pong buffer for the keys.
+    std::vector<std::uint64_t> keys_buffer {};
+
+    /// Ping-pong buffer for the indices.
+    std::vector<unsigned> indices_buffer {};
+
+    /// Digit histograms for all radix passes (6 passes of 11 bits).
+    std::array<unsigned, 6 * 2048> histograms {};
+};
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Maps a double to an unsigned integer with the same order.
+ *
+ * Positive numbers just get the sign bit set; negative numbers have all bits
+ * flipped. Negative zero is mapped as positive zero, so that both compare
+ * equal, as they do when comparing doubles. NaN is not supported.
+ */
+inline std::uint64_t argsortKey(const double value) {
+    // Adding zero turns -0.0 into +0.0.
+    const auto bits = std::bit_cast<std::uint64_t>(value + 0.0);
+    constexpr std::uint64_t SIGN_BIT = std::uint64_t(1) << 63;
+    return (bits & SIGN_BIT)? ~bits : (bits | SIGN_BIT);
+}
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Stable LSD radix argsort using digits of `DIGIT_BITS` bits.
+ * Used by argsort().
+ */
+template <unsigned DIGIT_BITS>
+void argsortRadix(const double* keys, const std::size_t size,
+                  unsigned* indices, ArgSortWorkspace& workspace) {
+    constexpr unsigned NUM_BUCKETS = 1u << DIGIT_BITS;
+    constexpr unsigned NUM_DIGITS = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+    constexpr std::uint64_t MASK = NUM_BUCKETS - 1;
+    static_assert(NUM_BUCKETS * NUM_DIGITS <=
+                  std::tuple_size_v<decltype(workspace.histograms)>);
+
+    auto* histograms = workspace.histograms.data();
+    std::fill(histograms, histograms + NUM_BUCKETS * NUM_DIGITS, 0u);
+
+    auto& mapped_keys = workspace.keys;
+    mapped_keys.resize(size);
+    for(std::size_t i = 0; i < size; ++i) {
+        auto key = argsortKey(keys[i]);
+        mapped_keys[i] = key;
+        for(unsigned d = 0; d < NUM_DIGITS; ++d, key >>= DIGIT_BITS)
+            ++histograms[d * NUM_BUCKETS + (key & MASK)];
+    }
+
+    workspace.keys_buffer.resize(size);
+    workspace.indices_buffer.resize(size);
+
+    auto* src_keys = mapped_keys.data();
+    auto* dst_keys = workspace.keys_buffer.data();
+    auto* src_indices = indices;
+    auto* dst_indices = workspace.indices_buffer.data();
+    bool first_pass = true;
+
+    for(unsigned d = 0; d < NUM_DIGITS; ++d) {
+        auto* histogram = histograms + d * NUM_BUCKETS;
+        const unsigned shift = d * DIGIT_BITS;
+
+        // If all keys share this digit, the pass does not change anything.
+        if(histogram[(src_keys[0] >> shift) & MASK] == size)
+            continue;
+
+        // Exclusive prefix sum gives the first position of each bucket.
+        unsigned sum = 0;
+        for(unsigned b = 0; b < NUM_BUCKETS; ++b) {
+            const auto tmp = histogram[b];
+            histogram[b] = sum;
+            sum += tmp;
+        }
+
+        if(first_pass) {
+            for(std::size_t i = 0; i < size; ++i) {
+                const auto key = src_keys[i];
+                const auto pos = histogram[(key >> shift) & MASK]++;
+                dst_keys[pos] = key;
+                dst_indices[pos] = static_cast<unsigned>(i);
+            }
+            first_pass = false;
+        }
+        else {
+            for(std::size_t i = 0; i < size; ++i) {
+                const auto key = src_keys[i];
+                const auto pos = histogram[(key >> shift) & MASK]++;
+                dst_keys[pos] = key;
+                dst_indices[pos] = src_indices[i];
+            }
+        }
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_indices, dst_indices);
+    }
+
+    // All keys are equal.
+    if(first_pass)
+        std::iota(indices, indices + size, 0u);
+    else
+    if(src_indices != indices)
+        std::copy(src_indices, src_indices + size, indices);
+}
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Computes the permutation that sorts the given keys (argsort).
+ *
+ * At the end, `keys[indices[0]] <= keys[indices[1]] <= ... `, and ties are
+ * broken by the smallest index. Therefore, the result is exactly the same of
+ * sorting the pairs `(keys[i], i)` using `std::sort()`, which is the usual
+ * way decoders build permutations from chromosomes.
+ *
+ * Small arrays are sorted by insertion. Larger arrays use a stable LSD radix
+ * sort over the IEEE-754 representation of the keys, i.e., linear time.
+ * Passes whose digit is the same for all keys are skipped.
+ *
+ * \param keys the keys to be sorted. They must not contain NaN.
+ * \param size the number of keys.
+ * \param[out] indices array with at least `size` positions to hold
+ *        the permutation.
+ * \param workspace scratch memory. It can be reused among calls, but it must
+ *        not be shared among threads concurrently.
+ */
+inline void argsort(const double* keys, const std::size_t size,
+                    unsigned* indices, ArgSortWorkspace& workspace) {
+    if(size <= ArgSortWorkspace::SMALL_SIZE) {
+        // Insertion sort over (key, index) pairs. Since indices are inserted
+        // in increasing order and we shift only strictly greater keys,
+        // the sort is stable.
+        for(std::size_t i = 0; i < size; ++i) {
+            const auto key = keys[i];
+            std::size_t j = i;
+            for(; j > 0 && keys[indices[j - 1]] > key; --j)
+                indices[j] = indices[j - 1];
+            indices[j] = static_cast<unsigned>(i);
+        }
+    }
+    else
+    if(size <= ArgSortWorkspace::MEDIUM_SIZE)
+        argsortRadix<8>(keys, size, indices, workspace);
+    else
+        argsortRadix<11>(keys, size, indices, workspace);
+}
+
+//----------------------------------------------------------------------------//
+
+/**
+ * \brief Computes the permutation that sorts the chromosome keys (argsort).
+ *
+ * \param chromosome the keys to be sorted.
+ * \param[out] indices the permutation. It is resized to the chromosome size.
+ * \param workspace scratch memory.
+ * \see argsort(const double*, std::size_t, unsigned*, ArgSortWorkspace&)
+ */
+inline void argsort(const Chromosome& chromosome,
+                    std::vector<unsigned>& indices,
+                    ArgSortWorkspace& workspace) {
+    indices.resize(chromosome.size());
+    argsort(chromosome.data(), chromosome.size(), indices.data(), workspace);
+}
+
+/**
+ * \brief Computes the permutation that sorts the chromosome keys (argsort).
+ *
+ * This version allocates the permutation on each call, and uses a scratch
+ * memory kept per thread. Prefer the versions using a pre-allocated
+ * workspace within decoders.
+ *
+ * \param chromosome the keys to be sorted.
+ * \return the permutation.
+ */
+inline std::vector<unsigned> argsort(const Chromosome& chromosome) {
+    std::vector<unsigned> indices(chromosome.size());
+    static thread_local ArgSortWorkspace workspace;
+    argsort(chromosome.data(), chromosome.size(), indices.data(), workspace);
+    return indices;
+}
+
+} // end namespace BRKGA
+
+#endif // BRKGA_MP_IPR_ARGSORT_HPP_
@@ -24,6 +24,7 @@
  *****************************************************************************/
 
 #include "decoders/tsp_decoder.hpp"
+#include "brkga_mp_ipr/argsort.hpp"
 
 #include <limits>
 #include <algorithm>
@@ -41,20 +42,15 @@ TSP_Decoder::TSP_Decoder(const TSP_Instance& _instance):
 
 BRKGA::fitness_t TSP_Decoder::decode(Chromosome& chromosome,
                                      bool /* not-used */) {
-    vector<pair<double, unsigned>> permutation(instance.num_nodes);
-    for(unsigned i = 0; i < instance.num_nodes; ++i)
-        permutation[i] = make_pair(chromosome[i], i);
-
-    sort(permutation.begin(), permutation.end());
+    // Nodes sorted by their keys.
+    const auto permutation = argsort(chromosome);
 
     double largest_edge = numeric_limits<double>::min();
 
-    double cost = instance.distance(permutation.front().second,
-                                    permutation.back().second);
+    double cost = instance.distance(permutation.front(), permutation.back());
 
     for(unsigned i = 0; i < instance.num_nodes - 1; ++i) {
-        auto dist = instance.distance(permutation[i].second,
-                                      permutation[i + 1].second);
+        auto dist = instance.distance(permutation[i], permutation[i + 1]);
 
         largest_edge = max(largest_edge, dist);
         cost += dist;
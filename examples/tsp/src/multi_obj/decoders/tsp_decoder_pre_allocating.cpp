@@ -37,7 +37,8 @@ TSP_Decoder_pre_allocating::TSP_Decoder_pre_allocating(
             const TSP_Instance& _instance, const unsigned num_threads):
     instance(_instance),
     // Pre-allocate space for permutations for each thread.
-    permutation_per_thread(num_threads, Permutation(instance.num_nodes))
+    permutation_per_thread(num_threads, Permutation(instance.num_nodes)),
+    workspace_per_thread(num_threads, ArgSortWorkspace(instance.num_nodes))
 {}
 
 //-------------------------------[ Decode ]-----------------------------------//
@@ -47,23 +48,20 @@ BRKGA::fitness_t TSP_Decoder_pre_allocating::decode(Chromosome& chromosome,
     // If you have OpenMP available, get the allocated memory per thread ID.
     #ifdef _OPENMP
     auto& permutation = permutation_per_thread[omp_get_thread_num()];
+    auto& workspace = workspace_per_thread[omp_get_thread_num()];
     #else
     auto& permutation = permutation_per_thread[0];
+    auto& workspace = workspace_per_thread[0];
     #endif
 
-    for(unsigned i = 0; i < instance.num_nodes; ++i)
-        permutation[i] = make_pair(chromosome[i], i);
-
-    sort(permutation.begin(), permutation.end());
+    argsort(chromosome, permutation, workspace);
 
     double largest_edge = numeric_limits<double>::min();
 
-    double cost = instance.distance(permutation.front().second,
-                                    permutation.back().second);
+    double cost = instance.distance(permutation.front(), permutation.back());
 
     for(unsigned i = 0; i < instance.num_nodes - 1; ++i) {
-        auto dist = instance.distance(permutation[i].second,
-                                      permutation[i + 1].second);
+        auto dist = instance.distance(permutation[i], permutation[i + 1]);
 
         largest_edge = max(largest_edge, dist);
         cost += dist;
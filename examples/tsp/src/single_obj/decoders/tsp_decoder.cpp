@@ -24,6 +24,7 @@
  *****************************************************************************/
 
 #include "decoders/tsp_decoder.hpp"
+#include "brkga_mp_ipr/argsort.hpp"
 
 #include <algorithm>
 
@@ -40,18 +41,13 @@ TSP_Decoder::TSP_Decoder(const TSP_Instance& _instance):
 
 BRKGA::fitness_t TSP_Decoder::decode(Chromosome& chromosome,
                                      bool /* not-used */) {
-    vector<pair<double, unsigned>> permutation(instance.num_nodes);
-    for(unsigned i = 0; i < instance.num_nodes; ++i)
-        permutation[i] = make_pair(chromosome[i], i);
+    // Nodes sorted by their keys.
+    const auto permutation = argsort(chromosome);
 
-    sort(permutation.begin(), permutation.end());
-
-    double cost = instance.distance(permutation.front().second,
-                                    permutation.back().second);
+    double cost = instance.distance(permutation.front(), permutation.back());
 
     for(unsigned i = 0; i < instance.num_nodes - 1; ++i)
-        cost += instance.distance(permutation[i].second,
-                                  permutation[i + 1].second);
+        cost += instance.distance(permutation[i], permutation[i + 1]);
 
     return cost;
 }
@@ -30,6 +30,7 @@
 #include "tsp/tsp_instance.hpp"
 #include "brkga_mp_ipr/fitness_type.hpp"
 #include "brkga_mp_ipr/chromosome.hpp"
+#include "brkga_mp_ipr/argsort.hpp"
 
 /**
  * \brief Interface for TSP_Decoder class.
@@ -64,13 +65,16 @@ public:
 
 protected:
     /// Defines a vector that holds node permutations during the decoding.
-    using Permutation = std::vector<std::pair<double, unsigned>>;
+    using Permutation = std::vector<unsigned>;
 
     /** For each thread, pre-allocate and hold memory for node permutation
      * during the decode. All memory is allocated in the constructor,
      * speeding up the decode process.
      */
     std::vector<Permutation> permutation_per_thread;
+
+    /// Scratch memory for argsort(), one per thread.
+    std::vector<BRKGA::ArgSortWorkspace> workspace_per_thread;
 };
 
 #endif // TSP_DECODER_PRE_ALLOCATING_HPP_
@@ -5,7 +5,7 @@
  * All Rights Reserved.
  *
  *  Created on : Jun 27, 2019 by ceandrade
- *  Last update: Sep 15, 2023 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
  *
  * This code is released under LICENSE.md.
  *
@@ -24,7 +24,10 @@
 
 #include "decoders.hpp"
 
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <memory>
 using namespace std;
 
 // Just sum the values.
@@ -49,3 +52,62 @@ double OrderDecoder::decode(BRKGA::Chromosome& chromosome, bool /*non-use*/) {
 
     return total;
 }
+
+// Sum of the distances of each key to the target (i * 7919 mod size) / size.
+double targetCost(const double* keys, const size_t size) {
+    double cost = 0.0;
+    for(size_t i = 0; i < size; ++i)
+        cost += fabs(keys[i] - double((i * 7919u) % size) / size);
+    return cost;
+}
+
+double TargetDecoder::decode(BRKGA::Chromosome& chromosome,
+                             bool /*non-used*/) {
+    return targetCost(chromosome.data(), chromosome.size());
+}
+
+// Same as targetCost(), with weights from 1 to 7 cycling over the keys.
+double weightedTargetCost(const double* keys, const size_t size) {
+    double cost = 0.0;
+    for(size_t i = 0; i < size; ++i)
+        cost += (1.0 + double(i % 7)) *
+                fabs(keys[i] - double((i * 7919u) % size) / size);
+    return cost;
+}
+
+double WeightedTargetDecoder::decode(BRKGA::Chromosome& chromosome,
+                                     bool /*non-used*/) {
+    ++num_calls;
+    return weightedTargetCost(chromosome.data(), chromosome.size());
+}
+
+//----------------------------[ Run scenarios ]------------------------------//
+
+ScenarioResult run_ipr_scenario(
+        const BRKGA::BrkgaParams& params,
+        const BRKGA::PathRelinking::Type pr_type,
+        shared_ptr<BRKGA::DistanceFunctionBase> dist,
+        const unsigned block_size, const unsigned chr_size,
+        const unsigned seed, const unsigned num_threads) {
+    using namespace BRKGA;
+
+    WeightedTargetDecoder decoder;
+    BRKGA_MP_IPR<WeightedTargetDecoder> algorithm(
+        decoder, Sense::MINIMIZE, seed, chr_size, params, num_threads);
+
+    const auto start = chrono::steady_clock::now();
+    for(unsigned i = 1; i <= 20; ++i) {
+        algorithm.evolve();
+        if(i % 5 == 0)
+            algorithm.pathRelink(pr_type,
+                                 PathRelinking::Selection::RANDOMELITE,
+                                 dist, params.pr_number_pairs, 0.0,
+                                 block_size, chrono::seconds {100},
+                                 params.pr_percentage);
+    }
+    const chrono::duration<double> elapsed =
+        chrono::steady_clock::now() - start;
+
+    return {algorithm.getBestFitness(), algorithm.getBestChromosome(),
+            decoder.num_calls, elapsed.count()};
+}
@@ -5,7 +5,7 @@
  * All Rights Reserved.
  *
  *  Created on : Jun 27, 2019 by ceandrade
- *  Last update: Sep 15, 2023 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
  *
  * This code is released under LICENSE.md.
  *
@@ -22,7 +22,16 @@
  * POSSIBILITY OF SUCH DAMAGE.
  *****************************************************************************/
 
-#include "chromosome.hpp"
+#ifndef DECODERS_HPP_
+#define DECODERS_HPP_
+
+#include "brkga_mp_ipr.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
 
 class SumDecoder {
     public:
@@ -33,3 +42,105 @@ class OrderDecoder {
     public:
         double decode(BRKGA::Chromosome& chromosome, bool foo = true);
 };
+
+/// Distance of the keys to a fixed target.
+double targetCost(const double* keys, std::size_t size);
+
+/// Evaluates the chromosome by #targetCost().
+class TargetDecoder {
+    public:
+        double decode(BRKGA::Chromosome& chromosome, bool foo = true);
+};
+
+/**
+ * Same as #targetCost(), but weighted by the key order, so that both block
+ * copies and key swaps change the cost.
+ */
+double weightedTargetCost(const double* keys, std::size_t size);
+
+/// Evaluates the chromosome by #weightedTargetCost(), counting the calls.
+class WeightedTargetDecoder {
+    public:
+        double decode(BRKGA::Chromosome& chromosome, bool foo = true);
+
+        std::atomic<std::size_t> num_calls {0};
+};
+
+//----------------------------[ Run scenarios ]------------------------------//
+
+/**
+ * Exercises all places where chromosomes are decoded: evolution, both path
+ * relinking types, injection, and shaking.
+ */
+template <class Decoder>
+void exercise_decodings(BRKGA::BRKGA_MP_IPR<Decoder>& algorithm,
+                        const BRKGA::BrkgaParams& params,
+                        const unsigned chr_size, const unsigned seed,
+                        const unsigned num_generations = 20) {
+    using namespace BRKGA;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    Chromosome chromosome(chr_size);
+
+    for(unsigned i = 1; i <= num_generations; ++i) {
+        algorithm.evolve();
+
+        if(i % 5 == 0) {
+            algorithm.pathRelink(
+                (i % 10 == 0)? PathRelinking::Type::DIRECT :
+                               PathRelinking::Type::PERMUTATION,
+                PathRelinking::Selection::BESTSOLUTION,
+                params.pr_distance_function,
+                params.pr_number_pairs, 0.0, 1, std::chrono::seconds {10},
+                params.pr_percentage);
+        }
+
+        if(i % 7 == 0) {
+            for(auto& key : chromosome)
+                key = uniform(rng);
+            algorithm.injectChromosome(chromosome, 0,
+                                       params.population_size - 1);
+        }
+
+        if(i % 8 == 0)
+            algorithm.shake(chr_size / 10, ShakingType::SWAP, 0);
+    }
+}
+
+/**
+ * Runs #exercise_decodings() on a new algorithm, minimizing, and returns the
+ * best fitness found.
+ */
+template <class Decoder>
+BRKGA::fitness_t run_scenario(Decoder& decoder,
+                              const BRKGA::BrkgaParams& params,
+                              const unsigned chr_size, const unsigned seed,
+                              const unsigned num_threads) {
+    BRKGA::BRKGA_MP_IPR<Decoder> algorithm(decoder, BRKGA::Sense::MINIMIZE,
+                                           seed, chr_size, params,
+                                           num_threads);
+    exercise_decodings(algorithm, params, chr_size, seed);
+    return algorithm.getBestFitness();
+}
+
+/// Outcome of #run_ipr_scenario().
+struct ScenarioResult {
+    BRKGA::fitness_t best_fitness;
+    BRKGA::Chromosome best_chromosome;
+    std::size_t num_decodes;
+    double elapsed;
+};
+
+/**
+ * Evolves 20 generations using #WeightedTargetDecoder, minimizing, and calls
+ * the path relinking between random elite chromosomes every 5 generations.
+ */
+ScenarioResult run_ipr_scenario(
+        const BRKGA::BrkgaParams& params,
+        const BRKGA::PathRelinking::Type pr_type,
+        std::shared_ptr<BRKGA::DistanceFunctionBase> dist,
+        const unsigned block_size, const unsigned chr_size,
+        const unsigned seed, const unsigned num_threads);
+
+#endif // DECODERS_HPP_
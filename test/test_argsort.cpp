@@ -0,0 +1,208 @@
+/******************************************************************************
+ * test_argsort.cpp: test argsort() kernel against std::sort.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "argsort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-----------------------------[ Reference ]---------------------------------//
+
+// This is the way most decoders build permutations.
+void reference_argsort(const Chromosome& chromosome,
+                       vector<pair<double, unsigned>>& permutation,
+                       vector<unsigned>& indices) {
+    permutation.resize(chromosome.size());
+    for(unsigned i = 0; i < chromosome.size(); ++i)
+        permutation[i] = make_pair(chromosome[i], i);
+
+    sort(permutation.begin(), permutation.end());
+
+    indices.resize(chromosome.size());
+    for(unsigned i = 0; i < chromosome.size(); ++i)
+        indices[i] = permutation[i].second;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned seed = (argc > 1)? atoi(argv[1]) : 2700001;
+
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    Chromosome chromosome;
+    vector<pair<double, unsigned>> permutation;
+    vector<unsigned> expected;
+    vector<unsigned> obtained;
+    ArgSortWorkspace workspace;
+
+    try {
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking correctness..." << endl;
+
+        for(unsigned size = 0; size < 300; ++size) {
+            for(unsigned trial = 0; trial < 20; ++trial) {
+                chromosome.resize(size);
+                switch(trial % 4) {
+                // Regular random keys.
+                case 0:
+                    for(auto& key : chromosome)
+                        key = uniform(rng);
+                    break;
+
+                // Lots of ties.
+                case 1:
+                    for(auto& key : chromosome)
+                        key = (rng() % 5) / 4.0;
+                    break;
+
+                // Negative numbers, zeros, and negative zeros.
+                case 2:
+                    for(auto& key : chromosome) {
+                        switch(rng() % 4) {
+                        case 0: key = 0.0; break;
+                        case 1: key = -0.0; break;
+                        case 2: key = -uniform(rng) * 1e6; break;
+                        default: key = uniform(rng) * 1e-300; break;
+                        }
+                    }
+                    break;
+
+                // All equal.
+                default:
+                    fill(chromosome.begin(), chromosome.end(), 0.5);
+                }
+
+                reference_argsort(chromosome, permutation, expected);
+                argsort(chromosome, obtained, workspace);
+
+                if(expected != obtained) {
+                    cerr << "\n*** argsort() differs from std::sort for size "
+                         << size << ", trial " << trial << endl;
+                    return 1;
+                }
+            }
+        }
+
+        for(const unsigned size : {10'000u, 100'000u, 1'000'000u}) {
+            chromosome.resize(size);
+            for(auto& key : chromosome)
+                key = uniform(rng);
+
+            reference_argsort(chromosome, permutation, expected);
+            argsort(chromosome, obtained, workspace);
+
+            if(expected != obtained) {
+                cerr << "\n*** argsort() differs from std::sort for size "
+                     << size << endl;
+                return 1;
+            }
+        }
+
+        // The convenience version reuses its scratch memory among calls of
+        // different sizes.
+        for(const unsigned size : {100'000u, 10u, 3000u, 1u, 500u}) {
+            chromosome.resize(size);
+            for(auto& key : chromosome)
+                key = uniform(rng);
+
+            reference_argsort(chromosome, permutation, expected);
+            if(expected != argsort(chromosome)) {
+                cerr << "\n*** argsort(chromosome) differs from std::sort "
+                     << "for size " << size << endl;
+                return 1;
+            }
+        }
+        cout << "All good!" << endl;
+
+        ////////////////////////////////////////
+        // Timing
+        ////////////////////////////////////////
+
+        cout << "\n> Timing (average per sort, microseconds)\n"
+             << setw(10) << "size" << setw(14) << "std::sort"
+             << setw(14) << "argsort" << setw(10) << "speedup"
+             << endl;
+
+        for(const unsigned size :
+            {100u, 1'000u, 10'000u, 100'000u, 1'000'000u}) {
+
+            const unsigned num_reps = max(5u, 20'000'000u / size);
+            vector<Chromosome> chromosomes(min(num_reps, 50u),
+                                           Chromosome(size));
+            for(auto& chr : chromosomes)
+                for(auto& key : chr)
+                    key = uniform(rng);
+
+            using namespace std::chrono;
+
+            auto start = steady_clock::now();
+            for(unsigned i = 0; i < num_reps; ++i)
+                reference_argsort(chromosomes[i % chromosomes.size()],
+                                  permutation, expected);
+            const auto ref_time =
+                duration<double, micro>(steady_clock::now() - start).count() /
+                num_reps;
+
+            start = steady_clock::now();
+            for(unsigned i = 0; i < num_reps; ++i)
+                argsort(chromosomes[i % chromosomes.size()],
+                        obtained, workspace);
+            const auto new_time =
+                duration<double, micro>(steady_clock::now() - start).count() /
+                num_reps;
+
+            if(expected != obtained)
+                throw runtime_error("argsort() differs from std::sort");
+
+            cout << setw(10) << size
+                 << setw(14) << fixed << setprecision(2) << ref_time
+                 << setw(14) << new_time
+                 << setw(10) << (ref_time / new_time)
+                 << endl;
+        }
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * test_ask_tell.cpp: test the ask/tell interface against a stand-in
+ * evaluation farm.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//------------------------------[ Evaluation ]-------------------------------//
+
+// Distance of the keys to a fixed target. When allowed, it rounds the keys,
+// as a local search would rewrite them.
+double evaluate(span<double> keys, const bool rewrite) {
+    if(rewrite)
+        for(auto& key : keys)
+            key = round(key * 1000.0) / 1000.0;
+
+    return targetCost(keys.data(), keys.size());
+}
+
+class Decoder {
+public:
+    double decode(Chromosome& chromosome, bool rewrite) {
+        return evaluate(span<double>(chromosome), rewrite);
+    }
+};
+
+// Stand-in for an evaluation farm: splits the batch among a few workers.
+vector<fitness_t> evaluate_on_farm(EvaluationBatch& batch) {
+    constexpr size_t NUM_WORKERS = 4;
+    vector<fitness_t> values(batch.size());
+    vector<future<void>> workers;
+    for(size_t w = 0; w < NUM_WORKERS; ++w) {
+        workers.push_back(async(launch::async, [&, w] {
+            for(size_t i = w; i < batch.size(); i += NUM_WORKERS)
+                values[i] = evaluate(batch.chromosomes[i], batch.rewrite);
+        }));
+    }
+    for(auto& worker : workers)
+        worker.get();
+    return values;
+}
+
+//----------------------------[ Run scenario ]-------------------------------//
+
+// Runs the shared scenario, and then run() with shaking, path relinking, and
+// elite exchange.
+fitness_t run_ask_tell_scenario(BRKGA_MP_IPR<Decoder>& algorithm,
+                                const BrkgaParams& params,
+                                ControlParams control_params,
+                                const unsigned chr_size,
+                                const unsigned seed) {
+    exercise_decodings(algorithm, params, chr_size, seed);
+
+    algorithm.setStoppingCriteria([](const AlgorithmStatus& status) {
+        return status.current_iteration >= 40;
+    });
+
+    control_params.maximum_running_time = chrono::seconds {1000};
+    control_params.shake_interval = 3;
+    control_params.ipr_interval = 4;
+    control_params.exchange_interval = 5;
+    control_params.reset_interval = 0;
+    control_params.stall_offset = 1000;
+
+    return algorithm.run(control_params, nullptr).best_fitness;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 2;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 2;
+        params.population_size = 100;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.3;
+        params.num_exchange_individuals = 2;
+
+        Decoder decoder;
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking ask/tell against regular decoding..." << endl;
+
+        vector<fitness_t> best_regular;
+        for(const unsigned s : {seed, seed + 1}) {
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, s,
+                                            chr_size, params, num_threads);
+            best_regular.push_back(
+                run_ask_tell_scenario(algorithm, params, control_params,
+                                      chr_size, s));
+        }
+
+        // Two instances overlapped by the same scheduler.
+        vector<fitness_t> best_ask_tell(2);
+        vector<unique_ptr<BRKGA_MP_IPR<Decoder>>> algorithms;
+        for(unsigned i = 0; i < 2; ++i) {
+            const unsigned s = seed + i;
+            algorithms.push_back(make_unique<BRKGA_MP_IPR<Decoder>>(
+                decoder, Sense::MINIMIZE, s, chr_size, params, num_threads));
+
+            auto& algorithm = *algorithms.back();
+            algorithm.beginAskTell([&, i, s] {
+                best_ask_tell[i] =
+                    run_ask_tell_scenario(algorithm, params, control_params,
+                                          chr_size, s);
+            });
+        }
+
+        vector<unsigned> num_batches(2, 0);
+        vector<size_t> num_evaluations(2, 0);
+        vector<bool> done(2, false);
+
+        while(!done[0] || !done[1]) {
+            vector<EvaluationBatch> batches(2);
+            for(unsigned i = 0; i < 2; ++i) {
+                if(done[i])
+                    continue;
+                batches[i] = algorithms[i]->ask();
+                done[i] = batches[i].empty();
+            }
+
+            // The first batch is the first initial population.
+            for(unsigned i = 0; i < 2; ++i) {
+                if(num_batches[i] == 0 && !done[i] &&
+                   batches[i].size() != params.population_size)
+                    throw runtime_error("Unexpected size of the first batch");
+            }
+
+            for(unsigned i = 0; i < 2; ++i) {
+                if(done[i])
+                    continue;
+                ++num_batches[i];
+                num_evaluations[i] += batches[i].size();
+                algorithms[i]->tell(evaluate_on_farm(batches[i]));
+            }
+        }
+
+        for(unsigned i = 0; i < 2; ++i) {
+            cout << "- instance " << i
+                 << " | batches: " << num_batches[i]
+                 << " | evaluations: " << num_evaluations[i]
+                 << " | best: " << best_regular[i] << " / " << best_ask_tell[i]
+                 << endl;
+
+            if(fabs(best_regular[i] - best_ask_tell[i]) > 1e-9)
+                throw runtime_error("Ask/tell changed the search trajectory");
+        }
+
+        ////////////////////////////////////////
+        // Errors
+        ////////////////////////////////////////
+
+        BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                        chr_size, params, num_threads);
+
+        bool thrown = false;
+        try {
+            algorithm.ask();
+        }
+        catch(runtime_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("ask() without a session must throw");
+
+        algorithm.beginAskTell([&] { algorithm.evolve(); });
+        auto batch = algorithm.ask();
+
+        thrown = false;
+        try {
+            algorithm.tell(vector<fitness_t>(batch.size() + 1, 0.0));
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("tell() with a wrong size must throw");
+
+        algorithm.tell(evaluate_on_farm(batch));
+        while(!(batch = algorithm.ask()).empty())
+            algorithm.tell(evaluate_on_farm(batch));
+
+        // Exceptions from the work reach the caller.
+        algorithm.beginAskTell([] { throw logic_error("work failed"); });
+        thrown = false;
+        try {
+            algorithm.ask();
+        }
+        catch(logic_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("Exceptions from the work must be propagated");
+
+        // Destroying the algorithm in the middle of a session cancels it.
+        {
+            BRKGA_MP_IPR<Decoder> abandoned(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, num_threads);
+            abandoned.beginAskTell([&] { abandoned.evolve(10); });
+            abandoned.ask();
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
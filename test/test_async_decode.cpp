@@ -0,0 +1,402 @@
+/******************************************************************************
+ * test_async_decode.cpp: test asynchronous decoders against a stand-in
+ * evaluation server over a Unix socket.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Socket I/O ]------------------------------//
+
+void write_all(const int fd, const void* data, size_t size) {
+    auto ptr = static_cast<const char*>(data);
+    while(size > 0) {
+        const auto n = ::write(fd, ptr, size);
+        if(n <= 0)
+            throw runtime_error("write() failed");
+        ptr += n;
+        size -= n;
+    }
+}
+
+bool read_all(const int fd, void* data, size_t size) {
+    auto ptr = static_cast<char*>(data);
+    while(size > 0) {
+        const auto n = ::read(fd, ptr, size);
+        if(n <= 0)
+            return false;
+        ptr += n;
+        size -= n;
+    }
+    return true;
+}
+
+sockaddr_un make_address(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+//----------------------------[ Stand-in server ]----------------------------//
+
+// Receives the chromosome size and keys, waits a while (as an external solver
+// would do), and replies with the fitness. One connection per evaluation.
+class EvaluationServer {
+public:
+    explicit EvaluationServer(const string& _path):
+        path(_path)
+    {
+        ::unlink(path.c_str());
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        const auto address = make_address(path);
+        if(listen_fd < 0 ||
+           ::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address),
+                  sizeof(address)) != 0 ||
+           ::listen(listen_fd, 128) != 0)
+            throw runtime_error("Cannot start the evaluation server");
+
+        acceptor = thread([this] { serve(); });
+    }
+
+    ~EvaluationServer() {
+        ::shutdown(listen_fd, SHUT_RDWR);
+        ::close(listen_fd);
+        acceptor.join();
+        ::unlink(path.c_str());
+    }
+
+    void serve() {
+        vector<thread> handlers;
+        for(;;) {
+            const int fd = ::accept(listen_fd, nullptr, nullptr);
+            if(fd < 0)
+                break;
+
+            handlers.emplace_back([fd] {
+                uint32_t size;
+                vector<double> keys;
+                if(read_all(fd, &size, sizeof(size))) {
+                    keys.resize(size);
+                    if(read_all(fd, keys.data(), size * sizeof(double))) {
+                        this_thread::sleep_for(chrono::microseconds(200));
+                        const double fitness = targetCost(keys.data(), size);
+                        write_all(fd, &fitness, sizeof(fitness));
+                    }
+                }
+                ::close(fd);
+            });
+
+            if(handlers.size() > 256) {
+                for(auto& handler : handlers)
+                    handler.join();
+                handlers.clear();
+            }
+        }
+        for(auto& handler : handlers)
+            handler.join();
+    }
+
+    const string path;
+    int listen_fd {-1};
+    thread acceptor {};
+};
+
+//-------------------------------[ Decoders ]--------------------------------//
+
+// Sends the chromosome to the server and waits for the reply in a
+// background task.
+class RemoteDecoder {
+public:
+    explicit RemoteDecoder(const string& _path):
+        path(_path)
+    {}
+
+    future<fitness_t> decodeAsync(Chromosome& chromosome,
+                                  bool /*not-used*/) {
+        const auto now = ++in_flight;
+        for(auto peak = max_in_flight.load();
+            now > peak && !max_in_flight.compare_exchange_weak(peak, now);)
+            ;
+        ++num_decodes;
+
+        return async(launch::async, [this, &chromosome] {
+            const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            const auto address = make_address(path);
+            if(fd < 0 ||
+               ::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                         sizeof(address)) != 0)
+                throw runtime_error("Cannot connect to the server");
+
+            const uint32_t size = chromosome.size();
+            double fitness = 0.0;
+            write_all(fd, &size, sizeof(size));
+            write_all(fd, chromosome.data(), size * sizeof(double));
+            const bool ok = read_all(fd, &fitness, sizeof(fitness));
+            ::close(fd);
+            --in_flight;
+
+            if(!ok)
+                throw runtime_error("Server closed the connection");
+            return fitness_t(fitness);
+        });
+    }
+
+    const string path;
+    atomic<unsigned> in_flight {0};
+    atomic<unsigned> max_in_flight {0};
+    atomic<unsigned> num_decodes {0};
+};
+
+// Always fails.
+class FailingDecoder {
+public:
+    future<fitness_t> decodeAsync(Chromosome& /*not-used*/,
+                                  bool /*not-used*/) {
+        return async(launch::async, []() -> fitness_t {
+            throw runtime_error("evaluation failed");
+        });
+    }
+};
+
+// Evaluates locally in a background task, using the decoding context. It
+// counts the decodings whose key ordering differs from argsort(), and those
+// with a cutoff.
+class ContextAsyncDecoder {
+public:
+    future<fitness_t> decodeAsync(Chromosome& chromosome, bool /*not-used*/,
+                                  DecodeContext& context) {
+        return async(launch::async, [this, &chromosome, &context] {
+            ++num_decodes;
+            if(context.keyOrder() != argsort(chromosome))
+                ++num_mismatches;
+            if(context.hasCutoff())
+                ++num_cutoffs;
+            return fitness_t(targetCost(chromosome.data(),
+                                        chromosome.size()));
+        });
+    }
+
+    atomic<unsigned> num_decodes {0};
+    atomic<unsigned> num_mismatches {0};
+    atomic<unsigned> num_cutoffs {0};
+};
+
+static_assert(!AsyncDecoder<TargetDecoder>);
+static_assert(AsyncDecoder<RemoteDecoder>);
+static_assert(!ContextAwareDecoder<RemoteDecoder>);
+static_assert(AsyncDecoder<ContextAsyncDecoder>);
+static_assert(ContextAwareDecoder<ContextAsyncDecoder>);
+
+//----------------------------[ Run scenario ]-------------------------------//
+
+// Runs the shared scenario, and then run() with a custom shaking, which
+// decodes the shaken chromosomes.
+template <class Decoder>
+fitness_t run_async_scenario(Decoder& decoder, const BrkgaParams& params,
+                             ControlParams control_params,
+                             const unsigned chr_size, const unsigned seed,
+                             const unsigned max_in_flight,
+                             unsigned& num_custom_shakes) {
+    BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed, chr_size,
+                                    params, 1);
+    if(max_in_flight > 0)
+        algorithm.setMaxInFlightDecodes(max_in_flight);
+
+    exercise_decodings(algorithm, params, chr_size, seed);
+
+    algorithm.setShakingMethod(
+        [&](double /*not-used*/, double /*not-used*/,
+            vector<shared_ptr<Population>>& populations,
+            vector<pair<unsigned, unsigned>>& shaken) {
+            ++num_custom_shakes;
+            auto& population = *populations[0];
+            for(unsigned idx = 0; idx < population.chromosomes.size();
+                idx += 3) {
+                for(auto& key : population.chromosomes[idx])
+                    key = 1.0 - key;
+                shaken.push_back({0, idx});
+            }
+        });
+
+    algorithm.setStoppingCriteria([](const AlgorithmStatus& status) {
+        return status.current_iteration >= 60;
+    });
+
+    control_params.maximum_running_time = chrono::seconds {1000};
+    control_params.shake_interval = 2;
+    control_params.exchange_interval = 0;
+    control_params.reset_interval = 0;
+    control_params.ipr_interval = 0;
+    control_params.stall_offset = 1000;
+
+    return algorithm.run(control_params, nullptr).best_fitness;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 200;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.3;
+
+        const string path = "/tmp/brkga_async_decode_" +
+                            to_string(::getpid()) + ".sock";
+        EvaluationServer server(path);
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking asynchronous decoding..." << endl;
+
+        unsigned num_shakes_local = 0;
+        TargetDecoder local;
+        const auto best_local =
+            run_async_scenario(local, params, control_params, chr_size,
+                               seed, 0, num_shakes_local);
+
+        for(const unsigned max_in_flight : {1u, 16u}) {
+            unsigned num_shakes_remote = 0;
+            RemoteDecoder remote(path);
+            const auto start = chrono::steady_clock::now();
+            const auto best_remote =
+                run_async_scenario(remote, params, control_params,
+                                   chr_size, seed, max_in_flight,
+                                   num_shakes_remote);
+            const chrono::duration<double> elapsed =
+                chrono::steady_clock::now() - start;
+
+            cout << "- in-flight limit: " << max_in_flight
+                 << " | decodes: " << remote.num_decodes
+                 << " | peak in flight: " << remote.max_in_flight
+                 << " | custom shakes: " << num_shakes_remote
+                 << " | time: " << elapsed.count() << "s"
+                 << " | best: " << best_local << " / " << best_remote
+                 << endl;
+
+            if(remote.max_in_flight > max_in_flight)
+                throw runtime_error("In-flight limit exceeded");
+
+            if(max_in_flight > 1 && remote.max_in_flight < 2)
+                throw runtime_error("Decodings were not overlapped");
+
+            if(num_shakes_remote != num_shakes_local ||
+               fabs(best_local - best_remote) > 1e-9)
+                throw runtime_error("Asynchronous decoding changed the "
+                                    "search trajectory");
+        }
+
+        // Context-aware asynchronous decoders get the context.
+        unsigned num_shakes_context = 0;
+        ContextAsyncDecoder context_decoder;
+        const auto best_context =
+            run_async_scenario(context_decoder, params, control_params,
+                               chr_size, seed, 16, num_shakes_context);
+
+        cout << "- context-aware | decodes: " << context_decoder.num_decodes
+             << " | key order mismatches: " << context_decoder.num_mismatches
+             << " | with cutoff: " << context_decoder.num_cutoffs
+             << " | best: " << best_local << " / " << best_context
+             << endl;
+
+        if(context_decoder.num_mismatches > 0 ||
+           context_decoder.num_cutoffs == 0)
+            throw runtime_error("The decoding context was not passed");
+
+        if(num_shakes_context != num_shakes_local ||
+           fabs(best_local - best_context) > 1e-9)
+            throw runtime_error("Asynchronous decoding changed the "
+                                "search trajectory");
+
+        ////////////////////////////////////////
+        // Errors
+        ////////////////////////////////////////
+
+        TargetDecoder dummy;
+        BRKGA_MP_IPR<TargetDecoder> algorithm(dummy, Sense::MINIMIZE, seed,
+                                              chr_size, params, 1);
+        bool thrown = false;
+        try {
+            algorithm.setMaxInFlightDecodes(0);
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("setMaxInFlightDecodes(0) must throw");
+
+        FailingDecoder failing;
+        BRKGA_MP_IPR<FailingDecoder> failing_algorithm(
+            failing, Sense::MINIMIZE, seed, chr_size, params, 1);
+        failing_algorithm.setMaxInFlightDecodes(8);
+        thrown = false;
+        try {
+            failing_algorithm.evolve();
+        }
+        catch(runtime_error& e) {
+            thrown = string(e.what()) == "evaluation failed";
+        }
+        if(!thrown)
+            throw runtime_error("Decoder exceptions must be propagated");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * test_block_size_tuner.cpp: test the tuner of the block size of the
+ * implicit path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned num_calls = (argc > 1)? atoi(argv[1]) : 2000;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        using PR = PathRelinking::PathRelinkingResult;
+        BlockSizeTuner tuner;
+
+        ////////////////////////////////////////
+        // Candidate sizes
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the candidate sizes..." << endl;
+
+        tuner.reset(8, 1, 64);
+        const vector<size_t> expected_order {8, 4, 16, 2, 32, 1, 64};
+        for(const auto expected : expected_order) {
+            const auto block_size = tuner.next();
+            if(block_size != expected)
+                throw runtime_error("Sizes not tried from the initial one "
+                                    "outwards");
+            tuner.update(10, 0.01, PR::NO_IMPROVEMENT);
+        }
+
+        // The initial size is clamped to the limits.
+        tuner.reset(100, 3, 20);
+        vector<size_t> sizes;
+        for(const auto& arm : tuner.getArms())
+            sizes.push_back(arm.block_size);
+        if(sizes != vector<size_t> {5, 10, 20})
+            throw runtime_error("Sizes out of the limits");
+
+        ////////////////////////////////////////
+        // Convergence
+        ////////////////////////////////////////
+
+        // Larger blocks make faster calls, but blocks beyond 16 seldom
+        // improve. The rate of improvements peaks at b = 16.
+        cout << "\n> Checking the convergence to the best rate..." << endl;
+
+        mt19937 rng(seed);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        tuner.reset(4, 1, 256);
+        for(unsigned i = 0; i < num_calls; ++i) {
+            const double block_size = double(tuner.next());
+            const double probability = (block_size <= 16.0)? 0.9 : 0.05;
+            const auto result = (uniform(rng) < probability)?
+                                PR::ELITE_IMPROVEMENT : PR::NO_IMPROVEMENT;
+            tuner.update(size_t(1000 / block_size), 1.0 / block_size,
+                         result);
+        }
+
+        const auto& arms = tuner.getArms();
+        for(const auto& arm : arms)
+            cout << "- block size: " << arm.block_size
+                 << " | calls: " << arm.num_calls
+                 << " | decodes: " << arm.num_decodes
+                 << " | improvements: " << arm.score
+                 << " | time: " << arm.seconds << "s"
+                 << endl;
+
+        const auto most_used = max_element(arms.begin(), arms.end(),
+            [](const auto& a, const auto& b) {
+                return a.num_calls < b.num_calls;
+            });
+        if(most_used->block_size != 16)
+            throw runtime_error("The tuner did not converge to the best "
+                                "size");
+
+        ////////////////////////////////////////
+        // Algorithm
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the adaptive block size on the algorithm..."
+             << endl;
+
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 100;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_adaptive_block_size = true;
+        params.pr_min_block_size = 1;
+        params.pr_max_block_size = 32;
+
+        WeightedTargetDecoder decoder;
+        BRKGA_MP_IPR<WeightedTargetDecoder> algorithm(
+            decoder, Sense::MINIMIZE, seed, 200, params, 2);
+        for(unsigned i = 1; i <= 30; ++i) {
+            algorithm.evolve();
+            if(i % 3 == 0)
+                algorithm.pathRelink(params.pr_distance_function,
+                                     chrono::seconds {10});
+        }
+        cout << "- best: " << algorithm.getBestFitness() << endl;
+
+        params.pr_min_block_size = 64;
+        bool thrown = false;
+        try {
+            BRKGA_MP_IPR<WeightedTargetDecoder> invalid(
+                decoder, Sense::MINIMIZE, seed, 200, params, 2);
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("Invalid block size limits must throw");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * test_bounded_decode.cpp: test the decoding with cutoffs.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Builds the cost key by key, and stops once the partial cost reaches the
+// cutoff, when allowed.
+class Decoder {
+public:
+    explicit Decoder(const bool _use_cutoff): use_cutoff(_use_cutoff) {}
+
+    double decode(Chromosome& chromosome, bool rewrite) {
+        DecodeContext context;
+        return decode(chromosome, rewrite, context);
+    }
+
+    double decode(Chromosome& chromosome, bool /*rewrite*/,
+                  DecodeContext& context) {
+        const bool stop_early = use_cutoff && context.hasCutoff();
+        double cost = 0.0;
+        for(size_t i = 0; i < chromosome.size(); ++i) {
+            ++num_keys;
+            cost += fabs(chromosome[i] -
+                         double((i * 7919u) % chromosome.size()) /
+                         chromosome.size());
+            if(stop_early && cost >= context.cutoff()) {
+                context.reportBound();
+                break;
+            }
+        }
+        return cost;
+    }
+
+    const bool use_cutoff;
+    atomic<unsigned long> num_keys {0};
+};
+
+double exact_cost(Chromosome chromosome) {
+    Decoder decoder(false);
+    return decoder.decode(chromosome, false);
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 2;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 2;
+        params.population_size = 100;
+        params.num_exchange_individuals = 2;
+        params.pr_type = PathRelinking::Type::DIRECT;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.3;
+
+        control_params.maximum_running_time = chrono::seconds {1000};
+        control_params.shake_interval = 0;
+        control_params.ipr_interval = 0;
+        control_params.exchange_interval = 0;
+        control_params.reset_interval = 0;
+        control_params.stall_offset = 1000;
+
+        cout << "\n> Checking the bounded decoding..." << endl;
+
+        const unsigned elite_size =
+            unsigned(params.elite_percentage * params.population_size);
+
+        vector<fitness_t> best_fitness;
+        for(const bool use_cutoff : {false, true}) {
+            Decoder decoder(use_cutoff);
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, num_threads);
+
+            // Bounded individuals are ranked after all exact ones, so they
+            // never reach the elite set.
+            algorithm.setStoppingCriteria([&](const AlgorithmStatus& status) {
+                for(unsigned pop = 0;
+                    pop < params.num_independent_populations; ++pop) {
+                    bool seen_bound = false;
+                    for(unsigned i = 0; i < params.population_size; ++i) {
+                        const bool bounded =
+                            algorithm.isFitnessApproximate(pop, i);
+                        if(seen_bound && !bounded)
+                            throw runtime_error("Bounds ranked before exact "
+                                                "values");
+                        if(bounded && i < elite_size)
+                            throw runtime_error("Bounded elite individual");
+                        seen_bound |= bounded;
+                    }
+                }
+
+                if(status.current_iteration % 20 == 0)
+                    algorithm.pathRelink(params.pr_distance_function,
+                                         chrono::seconds {10});
+
+                return status.current_iteration >= 100;
+            });
+
+            const auto status = algorithm.run(control_params, nullptr);
+
+            cout << "- cutoff: " << use_cutoff
+                 << " | keys evaluated: " << decoder.num_keys
+                 << " | bounded: " << status.num_bounded_decodes
+                 << " | best: " << status.best_fitness << endl;
+
+            if(fabs(exact_cost(status.best_chromosome) -
+                    status.best_fitness) > 1e-9)
+                throw runtime_error("The best fitness is a bound");
+
+            if(use_cutoff != (status.num_bounded_decodes > 0))
+                throw runtime_error("Unexpected number of bounded decodes");
+
+            best_fitness.push_back(status.best_fitness);
+        }
+
+        if(best_fitness[1] > 1.5 * best_fitness[0])
+            throw runtime_error("The cutoff degraded the search");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
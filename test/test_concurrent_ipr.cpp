@@ -0,0 +1,168 @@
+/******************************************************************************
+ * test_concurrent_ipr.cpp: test the concurrent relinking of several elite
+ * pairs in the path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//----------------------------[ Run scenario ]-------------------------------//
+
+ScenarioResult run_scenario(const BrkgaParams& params,
+                            const PathRelinking::Type pr_type,
+                            const unsigned chr_size, const unsigned seed,
+                            const unsigned num_threads) {
+    return run_ipr_scenario(params, pr_type, params.pr_distance_function, 1,
+                            chr_size, seed, num_threads);
+}
+
+bool same(const ScenarioResult& r1, const ScenarioResult& r2) {
+    return fabs(r1.best_fitness - r2.best_fitness) < 1e-9 &&
+           r1.best_chromosome == r2.best_chromosome &&
+           r1.num_decodes == r2.num_decodes;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.population_size = 100;
+        params.pr_number_pairs = 0;
+        params.pr_percentage = 1.0;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        // With a single population and a single pair, the concurrent IPR
+        // must walk the same path as the sequential one, with the signatures
+        // of the Hamming distance, the deferred blocks of the Kendall Tau
+        // distance, and the speculative decoding.
+        cout << "\n> Checking a single pair against the sequential IPR..."
+             << endl;
+
+        const vector<pair<PathRelinking::Type,
+                          shared_ptr<DistanceFunctionBase>>> cases {
+            {PathRelinking::Type::DIRECT, make_shared<HammingDistance>(0.5)},
+            {PathRelinking::Type::DIRECT, make_shared<KendallTauDistance>()},
+            {PathRelinking::Type::PERMUTATION,
+             make_shared<HammingDistance>(0.5)}
+        };
+
+        params.num_independent_populations = 1;
+        params.pr_streaming = true;
+        for(const auto& [pr_type, dist] : cases) {
+            params.pr_distance_function = dist;
+            for(const bool speculative : {false, true}) {
+                params.pr_speculative = speculative;
+
+                params.pr_concurrent_pairs = 0;
+                const auto sequential =
+                    run_scenario(params, pr_type, chr_size, seed, 3);
+
+                params.pr_concurrent_pairs = 1;
+                const auto concurrent =
+                    run_scenario(params, pr_type, chr_size, seed, 3);
+
+                cout << "- type: " << pr_type
+                     << " | speculative: " << speculative
+                     << " | decodes: " << sequential.num_decodes
+                     << " / " << concurrent.num_decodes
+                     << " | best: " << sequential.best_fitness
+                     << " / " << concurrent.best_fitness
+                     << endl;
+
+                if(!same(sequential, concurrent))
+                    throw runtime_error("A single concurrent pair changed "
+                                        "the path");
+            }
+        }
+
+        ////////////////////////////////////////
+        // Determinism
+        ////////////////////////////////////////
+
+        // Several pairs of several populations must be merged back in the
+        // same way, whatever the order the threads finish their decodings.
+        // Since the evolution depends on the number of threads, the runs
+        // use the same number of threads.
+        cout << "\n> Checking several pairs of several populations..." << endl;
+
+        params.num_independent_populations = 3;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_speculative = false;
+        for(const auto pr_type : {PathRelinking::Type::DIRECT,
+                                  PathRelinking::Type::PERMUTATION}) {
+            params.pr_concurrent_pairs = 0;
+            const auto sequential =
+                run_scenario(params, pr_type, chr_size, seed, 4);
+
+            params.pr_concurrent_pairs = 3;
+            const auto first_run =
+                run_scenario(params, pr_type, chr_size, seed, 4);
+            const auto second_run =
+                run_scenario(params, pr_type, chr_size, seed, 4);
+
+            cout << "- type: " << pr_type
+                 << " | decodes: " << sequential.num_decodes
+                 << " / " << first_run.num_decodes
+                 << " | time: " << sequential.elapsed << "s / "
+                 << first_run.elapsed << "s"
+                 << " | best: " << sequential.best_fitness
+                 << " / " << first_run.best_fitness
+                 << endl;
+
+            if(!same(first_run, second_run))
+                throw runtime_error("The concurrent paths are not "
+                                    "deterministic");
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
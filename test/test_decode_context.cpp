@@ -0,0 +1,251 @@
+/******************************************************************************
+ * test_decode_context.cpp: test context-aware decoders and key ordering.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoders ]--------------------------------//
+
+// Tour over random points in a line. Uses a full argsort on each decoding.
+class LineTourDecoder {
+public:
+    explicit LineTourDecoder(const vector<double>& _points):
+        points(_points)
+    {}
+
+    double tourCost(const vector<unsigned>& permutation) const {
+        double cost = fabs(points[permutation.front()] -
+                           points[permutation.back()]);
+        for(size_t i = 1; i < permutation.size(); ++i)
+            cost += fabs(points[permutation[i - 1]] -
+                         points[permutation[i]]);
+        return cost;
+    }
+
+    double decode(Chromosome& chromosome, bool /*not-used*/) {
+        return tourCost(argsort(chromosome));
+    }
+
+    const vector<double>& points;
+};
+
+// Same decoder, but using the key ordering kept by the framework.
+class LineTourContextDecoder: public LineTourDecoder {
+public:
+    explicit LineTourContextDecoder(const vector<double>& _points,
+                                    const bool _check):
+        LineTourDecoder(_points),
+        check(_check)
+    {}
+
+    using LineTourDecoder::decode;
+
+    double decode(Chromosome& chromosome, bool /*not-used*/,
+                  DecodeContext& context) {
+        const auto& permutation = context.keyOrder();
+        if(check) {
+            ++num_checks;
+            if(permutation != argsort(chromosome))
+                ++num_mismatches;
+        }
+        return tourCost(permutation);
+    }
+
+    const bool check;
+    atomic<unsigned> num_checks {0};
+    atomic<unsigned> num_mismatches {0};
+};
+
+static_assert(!ContextAwareDecoder<LineTourDecoder>);
+static_assert(ContextAwareDecoder<LineTourContextDecoder>);
+
+//-------------------------------[ Timing ]----------------------------------//
+
+// Exposes the framework interface to set the parent hint by hand.
+class HintedContext: public DecodeContext {
+public:
+    using DecodeContext::setChromosome;
+    using DecodeContext::setParentHint;
+};
+
+// Builds offspring of a single parent, replacing a share of the keys, and
+// returns the time per permutation (microseconds) using the parent hint and
+// using a full argsort.
+pair<double, double> time_key_order(const unsigned chr_size,
+                                    const double foreign_share,
+                                    mt19937& rng) {
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    constexpr unsigned NUM_OFFSPRING = 20;
+    constexpr unsigned NUM_REPS = 200;
+
+    Chromosome parent(chr_size);
+    for(auto& key : parent)
+        key = uniform(rng);
+    const auto parent_order = argsort(parent);
+
+    vector<Chromosome> offspring(NUM_OFFSPRING, parent);
+    vector<vector<unsigned>> foreign(NUM_OFFSPRING);
+    for(unsigned i = 0; i < NUM_OFFSPRING; ++i) {
+        for(unsigned j = 0; j < chr_size; ++j) {
+            if(uniform(rng) < foreign_share) {
+                offspring[i][j] = uniform(rng);
+                foreign[i].push_back(j);
+            }
+        }
+    }
+
+    HintedContext context;
+    ArgSortWorkspace workspace;
+    vector<unsigned> permutation;
+
+    // Both must give the same permutations.
+    for(unsigned i = 0; i < NUM_OFFSPRING; ++i) {
+        context.setChromosome(offspring[i]);
+        context.setParentHint(parent_order, foreign[i]);
+        argsort(offspring[i], permutation, workspace);
+        if(context.keyOrder() != permutation)
+            throw runtime_error("The parent hint built a wrong permutation");
+    }
+
+    auto start = chrono::steady_clock::now();
+    for(unsigned r = 0; r < NUM_REPS; ++r) {
+        context.setChromosome(offspring[r % NUM_OFFSPRING]);
+        context.setParentHint(parent_order, foreign[r % NUM_OFFSPRING]);
+        context.keyOrder();
+    }
+    const double hint_time =
+        chrono::duration<double, micro>(chrono::steady_clock::now() - start)
+        .count() / NUM_REPS;
+
+    start = chrono::steady_clock::now();
+    for(unsigned r = 0; r < NUM_REPS; ++r)
+        argsort(offspring[r % NUM_OFFSPRING], permutation, workspace);
+    const double full_time =
+        chrono::duration<double, micro>(chrono::steady_clock::now() - start)
+        .count() / NUM_REPS;
+
+    return {hint_time, full_time};
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 1000;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.pr_type = PathRelinking::Type::PERMUTATION;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::KENDALLTAU;
+        params.pr_distance_function = make_shared<KendallTauDistance>();
+        params.pr_minimum_distance = 0.0;
+        params.pr_percentage = 0.2;
+
+        mt19937 rng(seed);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        vector<double> points(chr_size);
+        for(auto& p : points)
+            p = uniform(rng);
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        // The scenario walks whole paths, so short chromosomes are used.
+        const unsigned short_size = min(chr_size, 100u);
+
+        cout << "\n> Checking key ordering consistency..." << endl;
+        for(const unsigned num_threads : {1u, 4u}) {
+            LineTourDecoder regular(points);
+            LineTourContextDecoder context(points, true);
+
+            const auto best_regular = run_scenario(regular, params,
+                                                   short_size, seed,
+                                                   num_threads);
+            const auto best_context = run_scenario(context, params,
+                                                   short_size, seed,
+                                                   num_threads);
+
+            cout << "- threads: " << num_threads
+                 << " | decodes checked: " << context.num_checks
+                 << " | mismatches: " << context.num_mismatches
+                 << " | best: " << best_regular << " / " << best_context
+                 << endl;
+
+            if(context.num_mismatches > 0)
+                throw runtime_error("Key ordering does not match argsort()");
+
+            if(fabs(best_regular - best_context) > 1e-9)
+                throw runtime_error("Context-aware decoding changed the "
+                                    "search trajectory");
+        }
+        cout << "All good!" << endl;
+
+        ////////////////////////////////////////
+        // Timing
+        ////////////////////////////////////////
+
+        // The hint only pays off when the decoder sorts long chromosomes
+        // and few keys come from other parents.
+        cout << "\n> Timing the key ordering of 100000 keys (microseconds)"
+             << endl;
+
+        for(const double foreign_share : {0.05, 0.1, 0.3}) {
+            const auto [hint_time, full_time] =
+                time_key_order(100'000, foreign_share, rng);
+
+            cout << "- foreign keys: " << foreign_share
+                 << " | parent hint: " << hint_time
+                 << " | full argsort: " << full_time
+                 << " | speedup: " << (full_time / hint_time)
+                 << endl;
+
+            if(foreign_share < 0.2 && hint_time >= full_time)
+                throw runtime_error("The parent hint did not save work");
+        }
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
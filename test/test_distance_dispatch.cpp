@@ -0,0 +1,158 @@
+/******************************************************************************
+ * test_distance_dispatch.cpp: test the static dispatch of the built-in
+ * distances in the path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------[ Derived distances ]-----------------------------//
+
+// Derived classes take the virtual path, but must behave exactly as the
+// built-in ones.
+class DerivedHamming: public HammingDistance {
+public:
+    using HammingDistance::HammingDistance;
+};
+
+class DerivedKendallTau: public KendallTauDistance {};
+
+//----------------------------[ Run scenario ]-------------------------------//
+
+ScenarioResult run_scenario(const BrkgaParams& params,
+                            shared_ptr<DistanceFunctionBase> dist,
+                            const unsigned block_size,
+                            const unsigned chr_size, const unsigned seed) {
+    return run_ipr_scenario(params, PathRelinking::Type::DIRECT, dist,
+                            block_size, chr_size, seed, 2);
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 100;
+        params.pr_number_pairs = 2;
+        params.pr_percentage = 1.0;
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking built-in against derived Hamming distances..."
+             << endl;
+
+        for(const unsigned block_size : {1u, 3u}) {
+            for(const bool streaming : {false, true}) {
+                params.pr_streaming = streaming;
+
+                const auto built_in =
+                    run_scenario(params, make_shared<HammingDistance>(0.5),
+                                 block_size, chr_size, seed);
+                const auto derived =
+                    run_scenario(params, make_shared<DerivedHamming>(0.5),
+                                 block_size, chr_size, seed);
+
+                cout << "- block size: " << block_size
+                     << " | streaming: " << streaming
+                     << " | decodes: " << built_in.num_decodes
+                     << " / " << derived.num_decodes
+                     << " | time: " << built_in.elapsed << "s / "
+                     << derived.elapsed << "s"
+                     << " | best: " << built_in.best_fitness
+                     << " / " << derived.best_fitness
+                     << endl;
+
+                if(fabs(built_in.best_fitness - derived.best_fitness) > 1e-9 ||
+                   built_in.best_chromosome != derived.best_chromosome ||
+                   built_in.num_decodes != derived.num_decodes)
+                    throw runtime_error("The static dispatch changed the "
+                                        "path");
+            }
+        }
+
+        ////////////////////////////////////////
+        // Kendall Tau block checks
+        ////////////////////////////////////////
+
+        // The built-in Kendall Tau distance does not decode the blocks that
+        // keep the key order, which derived classes cannot do. Therefore,
+        // their paths differ, but streaming must follow the same path.
+        cout << "\n> Checking the Kendall Tau block checks..." << endl;
+
+        for(const unsigned block_size : {1u, 3u}) {
+            params.pr_streaming = false;
+            const auto materialized =
+                run_scenario(params, make_shared<KendallTauDistance>(),
+                             block_size, chr_size, seed);
+            const auto derived =
+                run_scenario(params, make_shared<DerivedKendallTau>(),
+                             block_size, chr_size, seed);
+
+            params.pr_streaming = true;
+            const auto streaming =
+                run_scenario(params, make_shared<KendallTauDistance>(),
+                             block_size, chr_size, seed);
+
+            cout << "- block size: " << block_size
+                 << " | decodes: " << materialized.num_decodes
+                 << " / " << streaming.num_decodes
+                 << " (virtual: " << derived.num_decodes << ")"
+                 << " | best: " << materialized.best_fitness
+                 << " / " << streaming.best_fitness
+                 << " (virtual: " << derived.best_fitness << ")"
+                 << endl;
+
+            if(fabs(materialized.best_fitness - streaming.best_fitness)
+               > 1e-9 ||
+               materialized.best_chromosome != streaming.best_chromosome ||
+               materialized.num_decodes != streaming.num_decodes)
+                throw runtime_error("Streaming changed the path");
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
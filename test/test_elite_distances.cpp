@@ -0,0 +1,166 @@
+/******************************************************************************
+ * test_elite_distances.cpp: test the cache of distances between elite
+ * individuals used by the implicit path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//--------------------------[ Counting distance ]----------------------------//
+
+// Kendall tau distance that counts its calls.
+class CountingDistance: public KendallTauDistance {
+public:
+    double distance(const Chromosome& vector1,
+                    const Chromosome& vector2) override {
+        ++num_calls;
+        return KendallTauDistance::distance(vector1, vector2);
+    }
+
+    size_t num_calls {0};
+};
+
+// Hamming distance that counts its calls. Being a derived class, its
+// distances are not computed on signatures.
+class CountingHamming: public HammingDistance {
+public:
+    double distance(const Chromosome& vector1,
+                    const Chromosome& vector2) override {
+        ++num_calls;
+        return HammingDistance::distance(vector1, vector2);
+    }
+
+    size_t num_calls {0};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.population_size = 100;
+        params.pr_percentage = 0.2;
+
+        cout << "\n> Checking the elite distance cache..." << endl;
+
+        for(const unsigned num_populations : {1u, 3u}) {
+            params.num_independent_populations = num_populations;
+
+            TargetDecoder decoder;
+            BRKGA_MP_IPR<TargetDecoder> algorithm(decoder, Sense::MINIMIZE,
+                                                  seed, chr_size, params, 1);
+            algorithm.evolve(5);
+
+            const size_t elite_size = params.population_size *
+                                      params.elite_percentage;
+            auto dist = make_shared<CountingDistance>();
+
+            // No pair is far enough: all pairs are tested.
+            const double too_far = 1e12;
+            algorithm.pathRelink(PathRelinking::Type::DIRECT,
+                                 PathRelinking::Selection::RANDOMELITE, dist,
+                                 0, too_far, 1, chrono::seconds {100}, 0.2);
+            const auto first_calls = dist->num_calls;
+
+            // All pairs are cached now.
+            dist->num_calls = 0;
+            algorithm.pathRelink(PathRelinking::Type::DIRECT,
+                                 PathRelinking::Selection::BESTSOLUTION, dist,
+                                 0, too_far, 1, chrono::seconds {100}, 0.2);
+            const auto second_calls = dist->num_calls;
+
+            // Only the pairs of new elite individuals are computed.
+            algorithm.evolve(1);
+            dist->num_calls = 0;
+            algorithm.pathRelink(PathRelinking::Type::DIRECT,
+                                 PathRelinking::Selection::BESTSOLUTION, dist,
+                                 0, too_far, 1, chrono::seconds {100}, 0.2);
+            const auto third_calls = dist->num_calls;
+
+            const size_t num_pairs = (num_populations == 1)?
+                    elite_size * (elite_size - 1) / 2 :
+                    num_populations * elite_size * elite_size;
+
+            cout << "- populations: " << num_populations
+                 << " | distances: " << first_calls
+                 << " / " << second_calls
+                 << " / " << third_calls
+                 << " (pairs: " << num_pairs << ")"
+                 << endl;
+
+            if(first_calls != num_pairs)
+                throw runtime_error("Distances computed more than once");
+            if(second_calls != 0)
+                throw runtime_error("Cached distances were recomputed");
+            if(third_calls >= num_pairs)
+                throw runtime_error("Distances of remaining elite individuals "
+                                    "were recomputed");
+
+            // Another function, or other parameters, discard the cache.
+            auto hamming = make_shared<CountingHamming>();
+            const pair<double, size_t> runs[] {
+                {0.5, num_pairs}, {0.5, 0}, {0.3, num_pairs}
+            };
+            for(const auto& [threshold, expected_calls] : runs) {
+                hamming->threshold = threshold;
+                hamming->num_calls = 0;
+                algorithm.pathRelink(PathRelinking::Type::DIRECT,
+                                     PathRelinking::Selection::BESTSOLUTION,
+                                     hamming, 0, too_far, 1,
+                                     chrono::seconds {100}, 0.2);
+
+                cout << "- threshold: " << threshold
+                     << " | distances: " << hamming->num_calls << endl;
+
+                if(hamming->num_calls != expected_calls)
+                    throw runtime_error("Cached distances of another function "
+                                        "or threshold were reused");
+            }
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
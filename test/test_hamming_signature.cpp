@@ -0,0 +1,117 @@
+/******************************************************************************
+ * test_hamming_signature.cpp: test the threshold signatures and the early-exit
+ * queries of the Hamming distance.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned max_size = (argc > 1)? atoi(argv[1]) : 300;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        HammingDistance dist(0.5);
+
+        cout << "\n> Checking signatures against the keys..." << endl;
+
+        unsigned num_checks = 0;
+        for(unsigned size = 1; size <= max_size; size += 1 + size / 8) {
+            // Some keys are exactly the threshold.
+            Chromosome chr1(size), chr2(size);
+            for(unsigned i = 0; i < size; ++i) {
+                chr1[i] = (i % 11 == 0)? 0.5 : uniform(rng);
+                chr2[i] = (i % 13 == 0)? 0.5 : uniform(rng);
+            }
+
+            const auto num_words = HammingDistance::signatureSize(size);
+            vector<uint64_t> bits1(num_words), bits2(num_words);
+            dist.signature(chr1, bits1.data());
+            dist.signature(chr2, bits2.data());
+
+            const auto expected = dist.distance(chr1, chr2);
+            const auto value = HammingDistance::signatureDistance(
+                    bits1.data(), bits2.data(), num_words);
+            if(fabs(double(value) - expected) > 1e-9)
+                throw runtime_error("Different Hamming distance");
+
+            for(const double d : {0.0, 1.0, expected - 1.0, expected,
+                                  expected + 1.0, expected / 2.0,
+                                  double(size) + 1.0}) {
+                if(dist.atLeast(chr1, chr2, d) != (expected >= d))
+                    throw runtime_error("Wrong atLeast() answer");
+            }
+            ++num_checks;
+
+            for(unsigned block_size : {1u, 3u, 64u, 100u}) {
+                for(unsigned first = 0; first < size; first += block_size) {
+                    const unsigned count = min(block_size, size - first);
+                    const bool affects = dist.affectSolution(
+                            chr1.cbegin() + first, chr2.cbegin() + first,
+                            count);
+                    if(HammingDistance::signaturesDiffer(bits1.data(),
+                            bits2.data(), first, count) != affects)
+                        throw runtime_error("Different block check");
+
+                    // Copying the block and its bits gives the same
+                    // signature.
+                    Chromosome copy(chr1);
+                    copy_n(chr2.begin() + first, count, copy.begin() + first);
+                    vector<uint64_t> copy_bits(bits1), expected_bits(num_words);
+                    HammingDistance::copySignatureBits(bits2.data(),
+                            copy_bits.data(), first, count);
+                    dist.signature(copy, expected_bits.data());
+                    if(copy_bits != expected_bits)
+                        throw runtime_error("Different copied signature");
+                    ++num_checks;
+                }
+            }
+        }
+        cout << "- " << num_checks << " checks" << endl;
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * test_ipr_workspace.cpp: test that the implicit path relinking reuses its
+ * buffers.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//--------------------------[ Allocation counter ]---------------------------//
+
+atomic<size_t> num_allocations {0};
+
+void* operator new(size_t size) {
+    ++num_allocations;
+    if(void* ptr = malloc(size))
+        return ptr;
+    throw bad_alloc();
+}
+
+// GCC does not see that the replaced operator new uses malloc().
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+#pragma GCC diagnostic pop
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 100;
+        params.pr_number_pairs = 2;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 1.0;
+
+        cout << "\n> Checking the allocations of the path relinking..."
+             << endl;
+
+        for(const auto type : {PathRelinking::Type::DIRECT,
+                               PathRelinking::Type::PERMUTATION}) {
+            for(const bool streaming : {false, true}) {
+                params.pr_streaming = streaming;
+
+                WeightedTargetDecoder decoder;
+                BRKGA_MP_IPR<WeightedTargetDecoder> algorithm(
+                    decoder, Sense::MINIMIZE, seed, chr_size, params, 1);
+                algorithm.evolve(10);
+
+                vector<size_t> allocations;
+                for(unsigned i = 0; i < 4; ++i) {
+                    const size_t before = num_allocations;
+                    algorithm.pathRelink(type,
+                                         PathRelinking::Selection::RANDOMELITE,
+                                         params.pr_distance_function,
+                                         params.pr_number_pairs, 0.0, 1,
+                                         chrono::seconds {100},
+                                         params.pr_percentage);
+                    allocations.push_back(num_allocations - before);
+                }
+
+                cout << "- type: " << type
+                     << " | streaming: " << streaming
+                     << " | allocations:";
+                for(const auto value : allocations)
+                    cout << " " << value;
+                cout << endl;
+
+                // Only the first call sizes the workspace.
+                for(unsigned i = 1; i < allocations.size(); ++i)
+                    if(allocations[i] != 0)
+                        throw runtime_error("Path relinking allocated memory "
+                                            "in the steady state");
+            }
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
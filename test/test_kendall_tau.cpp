@@ -0,0 +1,378 @@
+/******************************************************************************
+ * test_kendall_tau.cpp: test the Kendall tau distance against the
+ * quadratic definition.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-----------------------------[ Decoder ]-----------------------------------//
+
+class ConstantDecoder {
+public:
+    double decode(Chromosome&, bool) { return 0.0; }
+};
+
+//----------------------------[ Reference ]----------------------------------//
+
+// The original quadratic implementation.
+double reference_distance(const Chromosome& vector1,
+                          const Chromosome& vector2) {
+    const size_t size = vector1.size();
+
+    vector<pair<double, size_t>> pairs_v1;
+    vector<pair<double, size_t>> pairs_v2;
+
+    pairs_v1.reserve(size);
+    size_t rank = 0;
+    for(const auto &v : vector1)
+        pairs_v1.emplace_back(v, ++rank);
+
+    pairs_v2.reserve(size);
+    rank = 0;
+    for(const auto &v : vector2)
+        pairs_v2.emplace_back(v, ++rank);
+
+    sort(begin(pairs_v1), end(pairs_v1));
+    sort(begin(pairs_v2), end(pairs_v2));
+
+    unsigned disagreements = 0;
+    for(size_t i = 0; i < size - 1; ++i) {
+        for(size_t j = i + 1; j < size; ++j) {
+            if((pairs_v1[i].second < pairs_v1[j].second
+                && pairs_v2[i].second > pairs_v2[j].second) ||
+               (pairs_v1[i].second > pairs_v1[j].second
+                && pairs_v2[i].second < pairs_v2[j].second))
+                ++disagreements;
+        }
+    }
+
+    return double(disagreements);
+}
+
+// Pairs of positions whose keys are in different order, ties broken by
+// position.
+double reference_position_distance(const Chromosome& vector1,
+                                   const Chromosome& vector2) {
+    unsigned disagreements = 0;
+    for(size_t i = 0; i < vector1.size(); ++i) {
+        for(size_t j = i + 1; j < vector1.size(); ++j)
+            disagreements += (vector1[j] < vector1[i]) !=
+                             (vector2[j] < vector2[i]);
+    }
+    return double(disagreements);
+}
+
+// Positions of the keys in increasing order, ties broken by position.
+vector<size_t> key_order(const Chromosome& vector1) {
+    vector<pair<double, size_t>> pairs;
+    for(size_t i = 0; i < vector1.size(); ++i)
+        pairs.emplace_back(vector1[i], i);
+    sort(begin(pairs), end(pairs));
+
+    vector<size_t> order;
+    for(const auto& p : pairs)
+        order.push_back(p.second);
+    return order;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned max_size = (argc > 1)? atoi(argv[1]) : 300;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        KendallTauDistance dist;
+
+        ////////////////////////////////////////
+        // Parity
+        ////////////////////////////////////////
+
+        cout << "\n> Checking parity with the quadratic definition..." << endl;
+
+        unsigned num_checks = 0;
+        for(unsigned size = 1; size <= max_size; size += 1 + size / 10) {
+            // Rounded keys produce ties.
+            for(const double rounding : {0.0, 10.0, 2.0}) {
+                Chromosome chr1(size), chr2(size);
+                for(unsigned i = 0; i < size; ++i) {
+                    chr1[i] = uniform(rng);
+                    chr2[i] = uniform(rng);
+                    if(rounding > 0.0) {
+                        chr1[i] = round(chr1[i] * rounding) / rounding;
+                        chr2[i] = round(chr2[i] * rounding) / rounding;
+                    }
+                }
+
+                // Also compare against itself and a partially equal vector.
+                Chromosome chr3(chr1);
+                for(unsigned i = 0; i < size / 2; ++i)
+                    chr3[i] = chr2[i];
+
+                for(const auto* other : {&chr1, &chr2, &chr3}) {
+                    const auto expected = reference_distance(chr1, *other);
+                    const auto value = dist.distance(chr1, *other);
+                    if(fabs(value - expected) > 1e-9) {
+                        cerr << "size " << size << ": " << value
+                             << " != " << expected << endl;
+                        throw runtime_error("Different Kendall tau distance");
+                    }
+
+                    for(const double d : {0.0, 1.0, expected - 1.0, expected,
+                                          expected + 1.0, expected / 2.0}) {
+                        if(dist.atLeast(chr1, *other, d) != (expected >= d))
+                            throw runtime_error("Wrong atLeast() answer");
+                    }
+                    ++num_checks;
+                }
+            }
+        }
+        cout << "- " << num_checks << " checks" << endl;
+
+        ////////////////////////////////////////
+        // Rankings
+        ////////////////////////////////////////
+
+        cout << "\n> Checking block order changes along paths..." << endl;
+
+        num_checks = 0;
+        unsigned num_changes = 0;
+        for(unsigned size = 2; size <= max_size; size += 1 + size / 5) {
+            for(const double rounding : {0.0, 10.0}) {
+                Chromosome point(size), guide(size);
+                for(unsigned i = 0; i < size; ++i) {
+                    point[i] = uniform(rng);
+                    // Guides close to the point keep the order often.
+                    guide[i] = point[i] + (uniform(rng) - 0.5) * 0.02;
+                    if(rounding > 0.0) {
+                        point[i] = round(point[i] * rounding) / rounding;
+                        guide[i] = round(guide[i] * rounding) / rounding;
+                    }
+                }
+
+                KendallTauDistance::Ranking rank;
+                KendallTauDistance::ranking(point, rank);
+
+                for(unsigned step = 0; step < 2 * size; ++step) {
+                    const size_t count = 1 + rng() % min(size, 5u);
+                    const size_t first = rng() % (size - count + 1);
+
+                    Chromosome moved(point);
+                    copy_n(guide.begin() + first, count,
+                           moved.begin() + first);
+
+                    const bool expected = key_order(point) != key_order(moved);
+                    if(KendallTauDistance::blockChangesOrder(rank,
+                            guide.begin() + first, first, count) != expected)
+                        throw runtime_error("Wrong block order change");
+                    ++num_checks;
+                    num_changes += expected;
+
+                    // Walk the path.
+                    if(rng() % 2 == 0) {
+                        point = moved;
+                        KendallTauDistance::replaceBlock(rank,
+                            guide.begin() + first, first, count);
+
+                        KendallTauDistance::Ranking fresh;
+                        KendallTauDistance::ranking(point, fresh);
+                        if(rank.keys != fresh.keys ||
+                           rank.sorted != fresh.sorted)
+                            throw runtime_error("Wrong ranking update");
+                    }
+                }
+            }
+        }
+        cout << "- " << num_checks << " checks, " << num_changes
+             << " order changes" << endl;
+
+        ////////////////////////////////////////
+        // Speed
+        ////////////////////////////////////////
+
+        const unsigned size = 10000;
+        Chromosome chr1(size), chr2(size);
+        for(unsigned i = 0; i < size; ++i) {
+            chr1[i] = uniform(rng);
+            chr2[i] = uniform(rng);
+        }
+
+        auto start = chrono::steady_clock::now();
+        const auto expected = reference_distance(chr1, chr2);
+        const chrono::duration<double> reference_time =
+            chrono::steady_clock::now() - start;
+
+        start = chrono::steady_clock::now();
+        const auto value = dist.distance(chr1, chr2);
+        const chrono::duration<double> time =
+            chrono::steady_clock::now() - start;
+
+        cout << "- size " << size << ": " << reference_time.count() << "s / "
+             << time.count() << "s" << endl;
+
+        if(fabs(value - expected) > 1e-9)
+            throw runtime_error("Different Kendall tau distance");
+
+        ////////////////////////////////////////
+        // Sampled estimates
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the sampled estimates..." << endl;
+
+        SampledKendallTauDistance sampled(0.01);
+
+        // Short chromosomes have fewer pairs than the sample.
+        for(const unsigned short_size : {1u, 2u, 50u, 200u}) {
+            for(const double rounding : {0.0, 10.0}) {
+                Chromosome short1(short_size), short2(short_size);
+                for(unsigned i = 0; i < short_size; ++i) {
+                    short1[i] = uniform(rng);
+                    short2[i] = uniform(rng);
+                    if(rounding > 0.0) {
+                        short1[i] = round(short1[i] * rounding) / rounding;
+                        short2[i] = round(short2[i] * rounding) / rounding;
+                    }
+                }
+                if(fabs(sampled.distance(short1, short2) -
+                        reference_position_distance(short1, short2)) > 1e-9)
+                    throw runtime_error("Short chromosomes must be exact");
+            }
+        }
+
+        const unsigned long_size = 200000;
+        const double num_pairs = double(long_size) * (long_size - 1) / 2.0;
+        const double tolerance = sampled.max_error * num_pairs;
+
+        Chromosome long1(long_size), long2(long_size), long3(long_size);
+        for(unsigned i = 0; i < long_size; ++i) {
+            long1[i] = uniform(rng);
+            long2[i] = uniform(rng);
+            // Mostly the same order as long1.
+            long3[i] = long1[i] + (uniform(rng) - 0.5) * 0.1;
+        }
+
+        for(const auto* other : {&long2, &long3}) {
+            start = chrono::steady_clock::now();
+            const auto exact =
+                SampledKendallTauDistance::exactDistance(long1, *other);
+            const chrono::duration<double> exact_time =
+                chrono::steady_clock::now() - start;
+
+            start = chrono::steady_clock::now();
+            const auto estimate = sampled.distance(long1, *other);
+            const chrono::duration<double> sampled_time =
+                chrono::steady_clock::now() - start;
+
+            cout << "- size " << long_size
+                 << " | sample: " << sampled.sampleSize()
+                 << " | distance: " << exact << " / " << estimate
+                 << " | time: " << exact_time.count() << "s / "
+                 << sampled_time.count() << "s" << endl;
+
+            if(fabs(estimate - exact) > tolerance)
+                throw runtime_error("Estimate out of the error bound");
+
+            if(fabs(sampled.maxError(long_size) - tolerance) > 1e-9 ||
+               sampled.maxError(200) > 0.0)
+                throw runtime_error("Wrong maximum error");
+
+            // The sample is fixed.
+            if(fabs(sampled.distance(long1, *other) - estimate) > 1e-9)
+                throw runtime_error("The sample must be fixed");
+
+            // Near the threshold, the exact distance decides.
+            for(const double d : {exact / 2.0, exact - 1.0, exact,
+                                  exact + 1.0, exact * 2.0}) {
+                if(sampled.atLeast(long1, *other, d) != (exact >= d))
+                    throw runtime_error("Wrong sampled atLeast() answer");
+            }
+        }
+
+        PathRelinking::DistanceFunctionType type {};
+        stringstream type_name("SAMPLED_KENDALLTAU");
+        type_name >> type;
+        if(type != PathRelinking::DistanceFunctionType::SAMPLED_KENDALLTAU)
+            throw runtime_error("Unknown distance function type");
+
+        // The functor built from a configuration takes the seed of the
+        // algorithm, while the ones built by the user keep their own.
+        stringstream config;
+        config << ifstream("config_full.conf").rdbuf();
+        string config_text = config.str();
+        const string hamming_line = "pr_distance_function_type HAMMING";
+        config_text.replace(config_text.find(hamming_line),
+                            hamming_line.size(),
+                            "pr_distance_function_type SAMPLED_KENDALLTAU");
+        config.str(config_text);
+
+        ostringstream logger;
+        auto [params, control_params] = readConfiguration(config, logger);
+        const auto* configured = dynamic_cast<SampledKendallTauDistance*>(
+                params.pr_distance_function.get());
+        if(configured == nullptr || !configured->use_algorithm_seed)
+            throw runtime_error("The configuration must set the seed");
+
+        for(const bool use_algorithm_seed : {true, false}) {
+            auto own = make_shared<SampledKendallTauDistance>(0.01, 1e-3, 7);
+            own->use_algorithm_seed = use_algorithm_seed;
+            params.pr_distance_function = own;
+
+            ConstantDecoder decoder;
+            BRKGA_MP_IPR<ConstantDecoder> algorithm(
+                decoder, Sense::MINIMIZE, seed, 50, params);
+            const auto* used = dynamic_cast<SampledKendallTauDistance*>(
+                algorithm.getBrkgaParams().pr_distance_function.get());
+
+            if(used->seed != (use_algorithm_seed? seed : 7u) ||
+               own->seed != 7u)
+                throw runtime_error("Wrong seed of the sampled distance");
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
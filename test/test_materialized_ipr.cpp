@@ -0,0 +1,160 @@
+/******************************************************************************
+ * test_materialized_ipr.cpp: test the paths walked by the materialized
+ * implicit path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Evaluates by weightedTargetCost(). While `recording`, it keeps the
+// chromosomes decoded without rewriting, i.e., the candidates of the path
+// relinking, and the fitness of the solution admitted at the end.
+class Decoder {
+public:
+    double decode(Chromosome& chromosome, bool rewrite) {
+        const double cost =
+            weightedTargetCost(chromosome.data(), chromosome.size());
+
+        if(recording) {
+            if(rewrite)
+                admitted.push_back(cost);
+            else {
+                candidates.push_back(chromosome);
+                fitness.push_back(cost);
+            }
+        }
+        return cost;
+    }
+
+    bool recording {false};
+    vector<Chromosome> candidates {};
+    vector<double> fitness {};
+    vector<double> admitted {};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 50;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+
+        for(const auto pr_type : {PathRelinking::Type::DIRECT,
+                                  PathRelinking::Type::PERMUTATION}) {
+            cout << "\n> Checking " << pr_type << endl;
+
+            Decoder decoder;
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, 1);
+
+            for(unsigned call = 0; call < 10; ++call) {
+                algorithm.evolve(5);
+
+                // The pair relinked is made of the two best individuals.
+                const auto base = algorithm.getChromosome(0, 0);
+                const auto guide = algorithm.getChromosome(0, 1);
+
+                decoder.candidates.clear();
+                decoder.fitness.clear();
+                decoder.admitted.clear();
+                decoder.recording = true;
+                algorithm.pathRelink(pr_type,
+                                     PathRelinking::Selection::BESTSOLUTION,
+                                     params.pr_distance_function, 2, 1.0,
+                                     1, chrono::seconds {10}, 0.5);
+                decoder.recording = false;
+
+                if(decoder.candidates.empty())
+                    continue;
+
+                // The admitted solution is the best candidate decoded.
+                const auto best = *min_element(decoder.fitness.begin(),
+                                               decoder.fitness.end());
+                if(decoder.admitted.size() != 1 ||
+                   fabs(decoder.admitted[0] - best) > 1e-9)
+                    throw runtime_error("The solution admitted is not the "
+                                        "best candidate");
+
+                if(pr_type != PathRelinking::Type::DIRECT)
+                    continue;
+
+                // In each step of the direct path relinking, all candidates
+                // of one side take one more key from the other end. So, the
+                // number of keys taken never decreases along a side.
+                const auto same = [](const double a, const double b) {
+                    return bit_cast<uint64_t>(a) == bit_cast<uint64_t>(b);
+                };
+
+                vector<size_t> last_taken(2, 0);
+                for(const auto& candidate : decoder.candidates) {
+                    size_t from_base = 0;
+                    size_t from_guide = 0;
+                    for(size_t i = 0; i < chr_size; ++i) {
+                        if(same(base[i], guide[i]))
+                            continue;
+                        from_base += same(candidate[i], base[i]);
+                        from_guide += same(candidate[i], guide[i]);
+                    }
+
+                    const size_t side = (from_base >= from_guide)? 0 : 1;
+                    const size_t taken = side == 0? from_guide : from_base;
+                    if(taken < last_taken[side])
+                        throw runtime_error("A committed block was lost");
+                    last_taken[side] = taken;
+                }
+            }
+        }
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/******************************************************************************
+ * test_multi_fidelity.cpp: test the multi-fidelity decoding.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoders ]--------------------------------//
+
+// The exact cost is targetCost(). The low-fidelity one looks only at
+// every fourth key, and scales the result.
+class Decoder {
+public:
+    double decode(Chromosome& chromosome, bool /*rewrite*/) {
+        return targetCost(chromosome.data(), chromosome.size());
+    }
+
+    double decode(Chromosome& chromosome, bool /*rewrite*/,
+                  DecodeContext& context) {
+        if(context.fidelity() == DecodeFidelity::HIGH) {
+            ++num_high;
+            return targetCost(chromosome.data(), chromosome.size());
+        }
+
+        ++num_low;
+        double cost = 0.0;
+        for(size_t i = 0; i < chromosome.size(); i += 4)
+            cost += fabs(chromosome[i] -
+                         double((i * 7919u) % chromosome.size()) /
+                         chromosome.size());
+        return 4.0 * cost;
+    }
+
+    atomic<unsigned> num_low {0};
+    atomic<unsigned> num_high {0};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 2;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 2;
+        params.population_size = 100;
+        params.num_exchange_individuals = 2;
+        params.pr_type = PathRelinking::Type::DIRECT;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.3;
+
+        control_params.maximum_running_time = chrono::seconds {1000};
+        control_params.shake_interval = 15;
+        control_params.ipr_interval = 10;
+        control_params.exchange_interval = 20;
+        control_params.reset_interval = 0;
+        control_params.stall_offset = 1000;
+
+        cout << "\n> Checking the multi-fidelity decoding..." << endl;
+
+        Decoder decoder;
+        BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                        chr_size, params, num_threads);
+        algorithm.setMultiFidelity(true);
+
+        const unsigned elite_size =
+            unsigned(params.elite_percentage * params.population_size);
+
+        // The elite sets hold high-fidelity fitness only, and so does the
+        // best solution reported to the observers.
+        const auto check_elite = [&](const AlgorithmStatus& status) {
+            for(unsigned pop = 0; pop < params.num_independent_populations;
+                ++pop) {
+                for(unsigned i = 0; i < elite_size; ++i) {
+                    if(algorithm.isFitnessApproximate(pop, i))
+                        throw runtime_error("Elite with low-fidelity fitness");
+                }
+            }
+            const auto& best = status.best_chromosome;
+            if(fabs(targetCost(best.data(), best.size()) -
+                    status.best_fitness) > 1e-9)
+                throw runtime_error("Best solution with low-fidelity fitness");
+            return status.current_iteration >= 60;
+        };
+
+        unsigned num_reports = 0;
+        algorithm.addNewSolutionObserver([&](const AlgorithmStatus& status) {
+            ++num_reports;
+            check_elite(status);
+            return true; // Keep going.
+        });
+        algorithm.setStoppingCriteria(check_elite);
+
+        const auto status = algorithm.run(control_params, nullptr);
+
+        cout << "- low/high decodes: " << decoder.num_low
+             << " / " << decoder.num_high
+             << " | reports: " << num_reports
+             << "\n" << status << endl;
+
+        if(status.num_high_fidelity_decodes == 0 ||
+           decoder.num_high >= decoder.num_low)
+            throw runtime_error("Unexpected number of high-fidelity decodes");
+
+        ////////////////////////////////////////
+        // Errors
+        ////////////////////////////////////////
+
+        TargetDecoder plain_decoder;
+        BRKGA_MP_IPR<TargetDecoder> plain(plain_decoder, Sense::MINIMIZE,
+                                          seed, chr_size, params,
+                                          num_threads);
+        bool thrown = false;
+        try {
+            plain.setMultiFidelity(true);
+        }
+        catch(runtime_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("Non-context-aware decoders must throw");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,345 @@
+/******************************************************************************
+ * test_pair_memory.cpp: test the memory of elite pairs relinked by the
+ * implicit path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Counts the decodings. Once `flat` is set, all chromosomes have the same
+// fitness, worse than any elite one, so the path relinking cannot change
+// the elite set. If `record` is set, the next chromosome is kept in `first`
+// (single thread only). Each decoding takes `delay_ms`.
+class Decoder {
+public:
+    double decode(Chromosome& chromosome, bool /*rewrite*/) {
+        ++num_decodes;
+        if(record) {
+            first = chromosome;
+            record = false;
+        }
+        if(delay_ms > 0)
+            this_thread::sleep_for(chrono::milliseconds(delay_ms));
+        if(flat)
+            return 1e9;
+        return targetCost(chromosome.data(), chromosome.size());
+    }
+
+    atomic<size_t> num_decodes {0};
+    bool flat {false};
+    bool record {false};
+    Chromosome first {};
+    unsigned delay_ms {0};
+};
+
+//---------------------------[ Repeated relinks ]----------------------------//
+
+// Relinks the same elite set `num_calls` times, and returns the number of
+// decodings of each call.
+vector<size_t> relink_repeatedly(const BrkgaParams& params,
+                                 const unsigned chr_size,
+                                 const unsigned seed,
+                                 const unsigned num_calls,
+                                 vector<PathRelinking::PathRelinkingResult>&
+                                    results) {
+    Decoder decoder;
+    BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed, chr_size,
+                                    params, 2);
+    algorithm.evolve(5);
+    decoder.flat = true;
+
+    vector<size_t> num_decodes;
+    results.clear();
+    for(unsigned i = 0; i < num_calls; ++i) {
+        const size_t start = decoder.num_decodes;
+        results.push_back(algorithm.pathRelink(
+            params.pr_type, PathRelinking::Selection::BESTSOLUTION,
+            params.pr_distance_function, 1, 0.0, 4, chrono::seconds {10},
+            params.pr_percentage));
+        num_decodes.push_back(decoder.num_decodes - start);
+    }
+    return num_decodes;
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        using PR = PathRelinking::PathRelinkingResult;
+
+        ////////////////////////////////////////
+        // Memory
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the memory..." << endl;
+
+        const auto key = [](uint64_t base, uint64_t guide,
+                            PathRelinking::Type type, size_t block_size) {
+            return RelinkedPairMemory::key(base, guide, type, block_size,
+                                           1.0);
+        };
+        using PathRelinking::Type;
+
+        RelinkedPairMemory memory(2);
+        memory.insert(key(1, 2, Type::DIRECT, 1));
+        memory.insert(key(1, 2, Type::DIRECT, 1));
+        memory.insert(key(2, 1, Type::DIRECT, 1));
+        if(memory.size() != 2 || !memory.contains(key(1, 2, Type::DIRECT, 1)))
+            throw runtime_error("Pairs are not ordered");
+
+        memory.insert(key(1, 2, Type::DIRECT, 2));
+        if(memory.contains(key(1, 2, Type::DIRECT, 1)) ||
+           !memory.contains(key(2, 1, Type::DIRECT, 1)) ||
+           !memory.contains(key(1, 2, Type::DIRECT, 2)))
+            throw runtime_error("The oldest pair was not forgotten");
+
+        if(key(1, 2, Type::PERMUTATION, 1) != key(1, 2, Type::PERMUTATION, 8))
+            throw runtime_error("Block size must not change permutation keys");
+
+        if(RelinkedPairMemory::key(1, 2, Type::DIRECT, 1, 1.0) ==
+           RelinkedPairMemory::key(1, 2, Type::DIRECT, 1, 0.5))
+            throw runtime_error("Percentage must change the keys");
+
+        RelinkedPairMemory disabled;
+        disabled.insert(key(1, 2, Type::DIRECT, 1));
+        if(disabled.contains(key(1, 2, Type::DIRECT, 1)))
+            throw runtime_error("A memory without capacity remembered");
+
+        ////////////////////////////////////////
+        // Path relinking
+        ////////////////////////////////////////
+
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 20;
+        params.elite_percentage = 0.15;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.5;
+
+        // Three elite individuals give six pairs.
+        const unsigned num_pairs = 6;
+        vector<PR> results;
+
+        for(const auto pr_type : {Type::DIRECT, Type::PERMUTATION}) {
+        for(const unsigned concurrent_pairs : {0u, 2u}) {
+            cout << "\n> Checking " << pr_type
+                 << " | concurrent pairs: " << concurrent_pairs << endl;
+
+            params.pr_type = pr_type;
+            params.pr_concurrent_pairs = concurrent_pairs;
+
+            params.pr_pair_memory_size = 0;
+            const auto decodes_without =
+                relink_repeatedly(params, chr_size, seed, num_pairs + 1,
+                                  results);
+            for(const auto decodes : decodes_without)
+                if(decodes == 0)
+                    throw runtime_error("Pairs skipped without memory");
+
+            params.pr_pair_memory_size = num_pairs;
+            const auto decodes_with =
+                relink_repeatedly(params, chr_size, seed, num_pairs + 1,
+                                  results);
+
+            // The best pair is relinked first, as without the memory.
+            if(decodes_with[0] != decodes_without[0])
+                throw runtime_error("The memory changed the first relinking");
+
+            const unsigned num_relinks = concurrent_pairs > 0?
+                                         num_pairs / concurrent_pairs :
+                                         num_pairs;
+            for(unsigned i = 0; i <= num_pairs; ++i) {
+                cout << "- call " << i
+                     << " | decodes: " << decodes_without[i]
+                     << " / " << decodes_with[i] << endl;
+
+                if((i < num_relinks) != (decodes_with[i] > 0))
+                    throw runtime_error("Unexpected skipped relinking");
+            }
+
+            if(results.back() != PR::NO_IMPROVEMENT)
+                throw runtime_error("Skipped pairs must not be homogeneous");
+        }}
+
+        ////////////////////////////////////////
+        // Sampled neighborhoods
+        ////////////////////////////////////////
+
+        cout << "\n> Checking sampled neighborhoods..." << endl;
+
+        // They walk a different path each time, so nothing is skipped.
+        params.pr_type = Type::DIRECT;
+        params.pr_concurrent_pairs = 0;
+        params.pr_neighborhood = PathRelinking::Neighborhood::SQUARE_ROOT;
+        params.pr_pair_memory_size = num_pairs;
+        for(const auto decodes :
+            relink_repeatedly(params, chr_size, seed, num_pairs + 1, results))
+            if(decodes == 0)
+                throw runtime_error("Pairs skipped with sampled moves");
+        params.pr_neighborhood = PathRelinking::Neighborhood::FULL;
+
+        ////////////////////////////////////////
+        // Adaptive block size
+        ////////////////////////////////////////
+
+        // Each call uses another block size. When the size is tuned online,
+        // it does not tell the paths apart, so the last call is skipped.
+        for(const bool adaptive : {false, true}) {
+            cout << "\n> Checking block sizes | adaptive: " << adaptive
+                 << endl;
+
+            params.pr_adaptive_block_size = adaptive;
+            Decoder decoder;
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, 1);
+            algorithm.evolve(5);
+            decoder.flat = true;
+
+            unsigned num_skipped = 0;
+            for(unsigned i = 0; i <= num_pairs; ++i) {
+                const size_t start = decoder.num_decodes;
+                algorithm.pathRelink(params.pr_type,
+                                     PathRelinking::Selection::BESTSOLUTION,
+                                     params.pr_distance_function, 1, 0.0,
+                                     1 + i, chrono::seconds {10},
+                                     params.pr_percentage);
+                num_skipped += decoder.num_decodes == start;
+            }
+            cout << "- skipped calls: " << num_skipped << endl;
+
+            if(num_skipped != (adaptive? 1u : 0u))
+                throw runtime_error("Unexpected skipped relinking");
+        }
+        params.pr_adaptive_block_size = false;
+
+        ////////////////////////////////////////
+        // Paths cut by the time limit
+        ////////////////////////////////////////
+
+        // The first candidate tells which pair is relinked.
+        for(const unsigned concurrent_pairs : {0u, 2u}) {
+            cout << "\n> Checking paths cut by the time limit"
+                 << " | concurrent pairs: " << concurrent_pairs << endl;
+
+            params.pr_concurrent_pairs = concurrent_pairs;
+            Decoder decoder;
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, 1);
+            algorithm.evolve(5);
+            decoder.flat = true;
+
+            vector<Chromosome> first_candidates;
+            for(const unsigned delay_ms : {20u, 0u, 0u}) {
+                decoder.delay_ms = delay_ms;
+                decoder.record = true;
+                decoder.first.clear();
+                const auto start = chrono::steady_clock::now();
+                algorithm.pathRelink(params.pr_type,
+                                     PathRelinking::Selection::BESTSOLUTION,
+                                     params.pr_distance_function, 1, 0.0, 4,
+                                     chrono::seconds {1},
+                                     params.pr_percentage);
+                const chrono::duration<double> elapsed =
+                    chrono::steady_clock::now() - start;
+                cout << "- delay: " << delay_ms << "ms"
+                     << " | time: " << elapsed.count() << "s" << endl;
+
+                if(decoder.first.empty())
+                    throw runtime_error("No pair was relinked");
+                if(delay_ms > 0 && elapsed.count() > 5.0)
+                    throw runtime_error("The path was not cut");
+                first_candidates.push_back(decoder.first);
+            }
+
+            if(first_candidates[0] != first_candidates[1])
+                throw runtime_error("A cut path was remembered");
+            if(first_candidates[1] == first_candidates[2])
+                throw runtime_error("A complete path was not remembered");
+        }
+
+        ////////////////////////////////////////
+        // Status
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the status counter..." << endl;
+
+        params.pr_type = Type::DIRECT;
+        params.pr_concurrent_pairs = 0;
+        params.pr_number_pairs = 1;
+        params.pr_minimum_distance = 0.0;
+        params.pr_pair_memory_size = num_pairs;
+
+        Decoder decoder;
+        BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                        chr_size, params, 2);
+        algorithm.evolve(5);
+        decoder.flat = true;
+
+        algorithm.setStoppingCriteria([](const AlgorithmStatus& status) {
+            return status.current_iteration >= 20;
+        });
+
+        control_params.maximum_running_time = chrono::seconds {1000};
+        control_params.ipr_interval = 1;
+        control_params.exchange_interval = 0;
+        control_params.shake_interval = 0;
+        control_params.reset_interval = 0;
+        control_params.stall_offset = 1000;
+
+        const auto status = algorithm.run(control_params, nullptr);
+        cout << "- skipped pairs: " << status.num_path_relink_skipped_pairs
+             << endl;
+
+        if(status.num_path_relink_skipped_pairs == 0)
+            throw runtime_error("Skipped pairs were not reported");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
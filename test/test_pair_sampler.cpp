@@ -0,0 +1,125 @@
+/******************************************************************************
+ * test_pair_sampler.cpp: test the sampler of base/guide pairs of the
+ * implicit path relinking.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned max_size = (argc > 1)? atoi(argv[1]) : 50;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        mt19937 rng(seed);
+        IprPairSampler sampler;
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking that all pairs are drawn once..." << endl;
+
+        for(unsigned size = 1; size <= max_size; ++size) {
+            for(const bool skip_same : {false, true}) {
+                for(const bool random : {false, true}) {
+                    sampler.reset(size, skip_same, random, rng);
+
+                    const size_t expected = size * size -
+                                            (skip_same? size : 0);
+                    if(sampler.numPairs() != expected)
+                        throw runtime_error("Wrong number of pairs");
+
+                    vector<unsigned> count(size * size, 0);
+                    size_t num_drawn = 0;
+                    size_t last_sum = 0;
+                    size_t num_in_order = 0;
+                    while(!sampler.empty()) {
+                        const auto [i, j] = sampler.next();
+                        if(i >= size || j >= size)
+                            throw runtime_error("Pair out of range");
+                        if(skip_same && i == j)
+                            throw runtime_error("Pair (i, i) drawn");
+                        if(!random && i + j < last_sum)
+                            throw runtime_error("Pairs are not best-first");
+                        if(i + j >= last_sum)
+                            ++num_in_order;
+                        last_sum = i + j;
+                        ++count[i * size + j];
+                        ++num_drawn;
+                    }
+
+                    if(num_drawn != expected)
+                        throw runtime_error("Wrong number of draws");
+                    for(const auto value : count)
+                        if(value > 1)
+                            throw runtime_error("Pair drawn twice");
+
+                    if(random && size == max_size && num_in_order == expected)
+                        throw runtime_error("Random pairs in best-first "
+                                            "order");
+                }
+            }
+        }
+
+        ////////////////////////////////////////
+        // Speed
+        ////////////////////////////////////////
+
+        const size_t elite_size = 2000;
+        const auto start = chrono::steady_clock::now();
+        sampler.reset(elite_size, true, true, rng);
+        size_t checksum = 0;
+        for(unsigned k = 0; k < 100000 && !sampler.empty(); ++k) {
+            const auto [i, j] = sampler.next();
+            checksum += i ^ j;
+        }
+        const chrono::duration<double> elapsed =
+            chrono::steady_clock::now() - start;
+
+        cout << "- 100000 draws with elite size " << elite_size << ": "
+             << elapsed.count() << "s (checksum " << checksum << ")" << endl;
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * test_payload.cpp: test the solution payloads attached by decoders.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <any>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// The decoded solution: a tour and its cost.
+struct Tour {
+    vector<unsigned> order;
+    double cost;
+};
+
+// Cost of visiting the positions in the order given by the keys.
+class Decoder {
+public:
+    double decode(Chromosome& /*chromosome*/, bool /*rewrite*/,
+                  DecodeContext& context) {
+        const auto& order = context.keyOrder();
+        double cost = 0.0;
+        for(size_t i = 0; i < order.size(); ++i)
+            cost += fabs(double(order[i]) -
+                         double((i * 7919u) % order.size()));
+        context.setPayload(Tour {order, cost});
+        return cost;
+    }
+};
+
+// Checks that the payload matches the chromosome and its fitness.
+void check_payload(const shared_ptr<const any>& payload,
+                   const Chromosome& chromosome, const fitness_t fitness) {
+    if(!payload)
+        throw runtime_error("Missing payload");
+
+    const auto& tour = any_cast<const Tour&>(*payload);
+    if(tour.order != argsort(chromosome) || fabs(tour.cost - fitness) > 1e-9)
+        throw runtime_error("The payload does not match the chromosome");
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 2;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 2;
+        params.population_size = 100;
+        params.num_exchange_individuals = 2;
+        params.pr_type = PathRelinking::Type::PERMUTATION;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::KENDALLTAU;
+        params.pr_distance_function = make_shared<KendallTauDistance>();
+        params.pr_percentage = 0.3;
+
+        control_params.maximum_running_time = chrono::seconds {1000};
+        control_params.shake_interval = 25;
+        control_params.ipr_interval = 10;
+        control_params.exchange_interval = 15;
+        control_params.reset_interval = 0;
+        control_params.stall_offset = 1000;
+
+        cout << "\n> Checking the solution payloads..." << endl;
+
+        Decoder decoder;
+        BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                        chr_size, params, num_threads);
+
+        const unsigned elite_size =
+            unsigned(params.elite_percentage * params.population_size);
+
+        // All elite individuals carry their payloads, the others none.
+        algorithm.setStoppingCriteria([&](const AlgorithmStatus& status) {
+            for(unsigned pop = 0; pop < params.num_independent_populations;
+                ++pop) {
+                const auto& population = algorithm.getCurrentPopulation(pop);
+                for(unsigned i = 0; i < elite_size; ++i) {
+                    const auto chr_idx = population.fitness[i].second;
+                    check_payload(population.payloads[chr_idx],
+                                  population.chromosomes[chr_idx],
+                                  population.fitness[i].first);
+                }
+            }
+            return status.current_iteration >= 60;
+        });
+
+        const auto status = algorithm.run(control_params, nullptr);
+        cout << "- best: " << status.best_fitness
+             << " | path relinks: " << status.num_path_relink_calls
+             << " | exchanges: " << status.num_exchanges
+             << " | shakes: " << status.num_shakes << endl;
+
+        check_payload(status.best_payload, status.best_chromosome,
+                      status.best_fitness);
+        check_payload(algorithm.getBestPayload(),
+                      algorithm.getBestChromosome(),
+                      algorithm.getBestFitness());
+
+        // Injected chromosomes get their payloads too.
+        Chromosome chromosome(chr_size);
+        for(unsigned i = 0; i < chr_size; ++i)
+            chromosome[(i * 7919u) % chr_size] = double(i) / chr_size;
+        algorithm.injectChromosome(chromosome, 0, 0);
+
+        if(algorithm.getBestFitness() > 1e-9)
+            throw runtime_error("The injected chromosome is not the best");
+        check_payload(algorithm.getBestPayload(), chromosome, 0.0);
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
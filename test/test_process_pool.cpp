@@ -0,0 +1,229 @@
+/******************************************************************************
+ * test_process_pool.cpp: test the decoder pool of worker processes.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+#include "process_decoder_pool.hpp"
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Mimics a decoder wrapping a non-reentrant library: all calls share the same
+// scratch buffer, unless `reentrant` is set (used as reference). It also
+// rounds the keys when allowed to rewrite them, and can be set to crash from
+// time to time. Chromosomes starting with a negative key crash it, and the
+// ones starting with a key above one make it throw.
+vector<double> library_scratch;
+
+class LegacyDecoder {
+public:
+    explicit LegacyDecoder(const unsigned _crash_every = 0,
+                           const unsigned _delay_us = 0,
+                           const bool _reentrant = false):
+        crash_every(_crash_every),
+        delay_us(_delay_us),
+        reentrant(_reentrant)
+    {}
+
+    double decode(Chromosome& chromosome, bool rewrite) {
+        ++num_calls;
+        if(crash_every > 0 && num_calls % crash_every == 0)
+            raise(SIGKILL);
+
+        // Poison chromosome.
+        if(chromosome[0] < 0.0)
+            raise(SIGKILL);
+
+        if(chromosome[0] > 1.0)
+            throw runtime_error("Key out of range");
+
+        if(rewrite)
+            for(auto& key : chromosome)
+                key = round(key * 100.0) / 100.0;
+
+        vector<double> local_scratch;
+        auto& scratch = reentrant? local_scratch : library_scratch;
+
+        scratch.assign(chromosome.begin(), chromosome.end());
+        if(delay_us > 0)
+            this_thread::sleep_for(chrono::microseconds(delay_us));
+
+        return targetCost(scratch.data(), scratch.size());
+    }
+
+    const unsigned crash_every;
+    const unsigned delay_us;
+    const bool reentrant;
+    unsigned num_calls {0};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_workers = 4;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 100;
+        params.pr_type = PathRelinking::Type::DIRECT;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 0.3;
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking the pool of worker processes..." << endl;
+
+        // Single-threaded run of the legacy decoder.
+        LegacyDecoder legacy_decoder(0, 20);
+        auto start = chrono::steady_clock::now();
+        run_scenario(legacy_decoder, params, chr_size, seed, 1);
+        const chrono::duration<double> legacy_time =
+            chrono::steady_clock::now() - start;
+
+        // Since the results depend on the number of threads, we compare the
+        // pool against a reentrant version using the same number of threads.
+        LegacyDecoder reference_decoder(0, 20, true);
+        const auto best_reference =
+            run_scenario(reference_decoder, params, chr_size, seed,
+                         num_workers);
+
+        for(const unsigned crash_every : {0u, 97u}) {
+            LegacyDecoder decoder(crash_every, 20);
+            ProcessDecoderPool<LegacyDecoder> pool(decoder, chr_size,
+                                                   num_workers);
+
+            start = chrono::steady_clock::now();
+            const auto best_pool =
+                run_scenario(pool, params, chr_size, seed, num_workers);
+            const chrono::duration<double> pool_time =
+                chrono::steady_clock::now() - start;
+
+            cout << "- crash every: " << crash_every
+                 << " | restarts: " << pool.getNumRestarts()
+                 << " | time: " << legacy_time.count() << "s / "
+                 << pool_time.count() << "s"
+                 << " | best: " << best_reference << " / " << best_pool
+                 << endl;
+
+            if(fabs(best_reference - best_pool) > 1e-9)
+                throw runtime_error("The pool changed the search trajectory");
+
+            if((crash_every > 0) != (pool.getNumRestarts() > 0))
+                throw runtime_error("Unexpected number of restarts");
+
+            if(decoder.num_calls != 0)
+                throw runtime_error("The main process decoded chromosomes");
+        }
+
+        ////////////////////////////////////////
+        // Poison chromosome
+        ////////////////////////////////////////
+
+        LegacyDecoder decoder;
+        ProcessDecoderPool<LegacyDecoder> pool(decoder, chr_size, 2, 1);
+
+        Chromosome chromosome(chr_size, 0.5);
+        chromosome[0] = -1.0;
+        bool thrown = false;
+        try {
+            pool.decode(chromosome, false);
+        }
+        catch(runtime_error&) {
+            thrown = true;
+        }
+        if(!thrown || pool.getNumRestarts() != 1)
+            throw runtime_error("Poison chromosome was not detected");
+
+        // The pool keeps working, and rewrites are sent back.
+        chromosome[0] = 0.123;
+        pool.decode(chromosome, true);
+        if(fabs(chromosome[0] - 0.12) > 1e-12)
+            throw runtime_error("Rewritten keys were not copied back");
+
+        ////////////////////////////////////////
+        // Decoder exceptions
+        ////////////////////////////////////////
+
+        // Reported in the caller, without restarting the worker.
+        const unsigned num_restarts = pool.getNumRestarts();
+        chromosome[0] = 2.0;
+        thrown = false;
+        try {
+            pool.decode(chromosome, false);
+        }
+        catch(runtime_error& e) {
+            thrown = string(e.what()).find("Key out of range") !=
+                     string::npos;
+        }
+        if(!thrown || pool.getNumRestarts() != num_restarts)
+            throw runtime_error("Decoder exception was not reported");
+
+        chromosome[0] = 0.5;
+        for(unsigned i = 0; i < 4; ++i)
+            pool.decode(chromosome, false);
+        if(pool.getNumRestarts() != num_restarts)
+            throw runtime_error("Workers died after a decoder exception");
+
+        thrown = false;
+        try {
+            ProcessDecoderPool<LegacyDecoder> empty_pool(decoder, chr_size, 0);
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("A pool without workers must throw");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
@@ -0,0 +1,267 @@
+/******************************************************************************
+ * test_streaming_ipr.cpp: test the implicit path relinking with candidates
+ * built on demand.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+#include "decoders.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//----------------------------[ Run scenario ]-------------------------------//
+
+ScenarioResult run_scenario(BrkgaParams params, const PathRelinking::Type type,
+                            const bool streaming, const unsigned chr_size,
+                            const unsigned seed, const unsigned num_threads) {
+    params.pr_streaming = streaming;
+    return run_ipr_scenario(params, type, params.pr_distance_function, 1,
+                            chr_size, seed, num_threads);
+}
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 100;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 100;
+        params.pr_number_pairs = 2;
+        params.pr_distance_function_type =
+            PathRelinking::DistanceFunctionType::HAMMING;
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_percentage = 1.0;
+
+        ////////////////////////////////////////
+        // Correctness
+        ////////////////////////////////////////
+
+        cout << "\n> Checking streaming against materialized candidates..."
+             << endl;
+
+        for(const auto type : {PathRelinking::Type::DIRECT,
+                               PathRelinking::Type::PERMUTATION}) {
+            for(const unsigned num_threads : {1u, 4u}) {
+                const auto materialized =
+                    run_scenario(params, type, false, chr_size, seed,
+                                 num_threads);
+                const auto streaming =
+                    run_scenario(params, type, true, chr_size, seed,
+                                 num_threads);
+
+                cout << "- type: " << type
+                     << " | threads: " << num_threads
+                     << " | decodes: " << materialized.num_decodes
+                     << " / " << streaming.num_decodes
+                     << " | time: " << materialized.elapsed << "s / "
+                     << streaming.elapsed << "s"
+                     << " | best: " << materialized.best_fitness
+                     << " / " << streaming.best_fitness
+                     << endl;
+
+                if(fabs(materialized.best_fitness - streaming.best_fitness)
+                   > 1e-9 ||
+                   materialized.best_chromosome != streaming.best_chromosome)
+                    throw runtime_error("Streaming changed the path");
+
+                if(materialized.num_decodes != streaming.num_decodes)
+                    throw runtime_error("Streaming changed the number of "
+                                        "decodes");
+            }
+        }
+
+        ////////////////////////////////////////
+        // Speculative decoding
+        ////////////////////////////////////////
+
+        // Decoding candidates of the next step ahead of time must not change
+        // the path, for both paths and with the Kendall Tau block checks,
+        // whether the candidates are streamed or materialized.
+        cout << "\n> Checking speculative decoding of the next steps..."
+             << endl;
+
+        const vector<pair<PathRelinking::Type,
+                          shared_ptr<DistanceFunctionBase>>> cases {
+            {PathRelinking::Type::DIRECT, make_shared<HammingDistance>(0.5)},
+            {PathRelinking::Type::DIRECT, make_shared<KendallTauDistance>()},
+            {PathRelinking::Type::PERMUTATION,
+             make_shared<HammingDistance>(0.5)}
+        };
+
+        for(const auto& [type, dist] : cases) {
+            params.pr_distance_function = dist;
+            for(const unsigned num_threads : {3u, 4u}) {
+                params.pr_speculative = false;
+                const auto streaming =
+                    run_scenario(params, type, true, chr_size, seed,
+                                 num_threads);
+
+                params.pr_speculative = true;
+                for(const bool streamed : {true, false}) {
+                    const auto speculative =
+                        run_scenario(params, type, streamed, chr_size, seed,
+                                     num_threads);
+
+                    cout << "- type: " << type
+                         << " | threads: " << num_threads
+                         << " | streaming: " << streamed
+                         << " | decodes: " << streaming.num_decodes
+                         << " / " << speculative.num_decodes
+                         << " | time: " << streaming.elapsed << "s / "
+                         << speculative.elapsed << "s"
+                         << " | best: " << streaming.best_fitness
+                         << " / " << speculative.best_fitness
+                         << endl;
+
+                    if(fabs(streaming.best_fitness -
+                            speculative.best_fitness) > 1e-9 ||
+                       streaming.best_chromosome !=
+                       speculative.best_chromosome)
+                        throw runtime_error("Speculative decoding changed "
+                                            "the path");
+
+                    if(speculative.num_decodes < streaming.num_decodes)
+                        throw runtime_error("Speculative decoding skipped "
+                                            "candidates");
+                }
+            }
+        }
+
+        ////////////////////////////////////////
+        // Sampled neighborhoods
+        ////////////////////////////////////////
+
+        // Both kinds of candidates draw the same samples, so they must walk
+        // the same path, decoding fewer candidates than the full steps.
+        cout << "\n> Checking sampled neighborhoods..." << endl;
+
+        params.pr_distance_function = make_shared<HammingDistance>(0.5);
+        params.pr_speculative = false;
+        params.pr_neighborhood_size = 5;
+
+        for(const auto type : {PathRelinking::Type::DIRECT,
+                               PathRelinking::Type::PERMUTATION}) {
+            params.pr_neighborhood = PathRelinking::Neighborhood::FULL;
+            const auto full =
+                run_scenario(params, type, true, chr_size, seed, 4);
+
+            for(const auto neighborhood :
+                {PathRelinking::Neighborhood::SQUARE_ROOT,
+                 PathRelinking::Neighborhood::FIXED}) {
+                params.pr_neighborhood = neighborhood;
+                const auto materialized =
+                    run_scenario(params, type, false, chr_size, seed, 4);
+                const auto streaming =
+                    run_scenario(params, type, true, chr_size, seed, 4);
+
+                cout << "- type: " << type
+                     << " | neighborhood: " << neighborhood
+                     << " | decodes: " << full.num_decodes
+                     << " / " << materialized.num_decodes
+                     << " / " << streaming.num_decodes
+                     << " | time: " << full.elapsed << "s / "
+                     << materialized.elapsed << "s / "
+                     << streaming.elapsed << "s"
+                     << " | best: " << full.best_fitness
+                     << " / " << materialized.best_fitness
+                     << " / " << streaming.best_fitness
+                     << endl;
+
+                if(fabs(materialized.best_fitness - streaming.best_fitness)
+                   > 1e-9 ||
+                   materialized.best_chromosome != streaming.best_chromosome ||
+                   materialized.num_decodes != streaming.num_decodes)
+                    throw runtime_error("Streaming changed the sampled path");
+
+                if(streaming.num_decodes >= full.num_decodes)
+                    throw runtime_error("Sampling did not save decodes");
+            }
+        }
+
+        // The saved decodes are reported on the algorithm status.
+        {
+            params.pr_neighborhood = PathRelinking::Neighborhood::SQUARE_ROOT;
+            params.pr_type = PathRelinking::Type::DIRECT;
+
+            WeightedTargetDecoder decoder;
+            BRKGA_MP_IPR<WeightedTargetDecoder> algorithm(
+                decoder, Sense::MINIMIZE, seed, chr_size, params, 4);
+            algorithm.setStoppingCriteria([](const AlgorithmStatus& status) {
+                return status.current_iteration >= 20;
+            });
+
+            control_params.maximum_running_time = chrono::seconds {1000};
+            control_params.ipr_interval = 1;
+            control_params.stall_offset = 1000;
+            const auto status = algorithm.run(control_params, nullptr);
+
+            cout << "- path relinking calls: " << status.num_path_relink_calls
+                 << " | saved decodes: "
+                 << status.num_path_relink_saved_decodes
+                 << endl;
+
+            if(status.num_path_relink_calls > 1 &&
+               status.num_path_relink_saved_decodes == 0)
+                throw runtime_error("Saved decodes were not reported");
+        }
+
+        // A fixed neighborhood needs a size.
+        params.pr_neighborhood = PathRelinking::Neighborhood::FIXED;
+        params.pr_neighborhood_size = 0;
+        bool thrown = false;
+        try {
+            WeightedTargetDecoder decoder;
+            BRKGA_MP_IPR<WeightedTargetDecoder> algorithm(
+                decoder, Sense::MINIMIZE, seed, chr_size, params, 1);
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("A fixed neighborhood without size must "
+                                "throw");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
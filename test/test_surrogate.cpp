@@ -0,0 +1,168 @@
+/******************************************************************************
+ * test_surrogate.cpp: test the surrogate pre-screening of offspring.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "brkga_mp_ipr.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Smooth landscape, so that close chromosomes have close fitness.
+class Decoder {
+public:
+    double decode(Chromosome& chromosome, bool /*rewrite*/) {
+        ++num_calls;
+        double cost = 0.0;
+        for(size_t i = 0; i < chromosome.size(); ++i) {
+            const double diff =
+                chromosome[i] - double((i * 7919u) % chromosome.size()) /
+                                chromosome.size();
+            cost += diff * diff;
+        }
+        return cost;
+    }
+
+    unsigned num_calls {0};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 50;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 2;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 2;
+        params.population_size = 100;
+        params.num_exchange_individuals = 2;
+
+        control_params.maximum_running_time = chrono::seconds {1000};
+        control_params.shake_interval = 0;
+        control_params.ipr_interval = 0;
+        control_params.exchange_interval = 10;
+        control_params.reset_interval = 0;
+        control_params.stall_offset = 1000;
+
+        const auto stop = [](const AlgorithmStatus& status) {
+            return status.current_iteration >= 100;
+        };
+
+        cout << "\n> Checking the surrogate pre-screening..." << endl;
+
+        Decoder full_decoder;
+        BRKGA_MP_IPR<Decoder> full(full_decoder, Sense::MINIMIZE, seed,
+                                   chr_size, params, num_threads);
+        full.setStoppingCriteria(stop);
+        const auto full_status = full.run(control_params, nullptr);
+
+        Decoder decoder;
+        BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                        chr_size, params, num_threads);
+        algorithm.setSurrogateModel(make_shared<KNearestSurrogate>(5, 500),
+                                    0.25);
+        algorithm.setStoppingCriteria([&](const AlgorithmStatus& status) {
+            // The elite sets hold decoded fitness only.
+            const unsigned elite_size =
+                unsigned(params.elite_percentage * params.population_size);
+            for(unsigned pop = 0; pop < params.num_independent_populations;
+                ++pop) {
+                for(unsigned i = 0; i < elite_size; ++i) {
+                    if(algorithm.isFitnessApproximate(pop, i))
+                        throw runtime_error("Elite with estimated fitness");
+                }
+            }
+            return stop(status);
+        });
+        const auto status = algorithm.run(control_params, nullptr);
+
+        cout << "- decodes: " << full_decoder.num_calls
+             << " / " << decoder.num_calls
+             << " | best: " << full_status.best_fitness
+             << " / " << status.best_fitness
+             << "\n" << status << endl;
+
+        if(status.num_surrogate_decodes == 0 ||
+           status.num_surrogate_estimates == 0 ||
+           status.num_surrogate_promotions == 0)
+            throw runtime_error("The surrogate was not used");
+
+        if(decoder.num_calls >= full_decoder.num_calls / 2)
+            throw runtime_error("The surrogate did not save decodes");
+
+        // The best solution must be a decoded one.
+        Chromosome best = algorithm.getBestChromosome();
+        if(fabs(decoder.decode(best, false) - status.best_fitness) > 1e-9)
+            throw runtime_error("The best fitness is an estimate");
+
+        ////////////////////////////////////////
+        // Errors
+        ////////////////////////////////////////
+
+        for(const double fraction : {0.0, 1.5}) {
+            bool thrown = false;
+            try {
+                algorithm.setSurrogateModel(
+                    make_shared<KNearestSurrogate>(), fraction);
+            }
+            catch(range_error&) {
+                thrown = true;
+            }
+            if(!thrown)
+                throw runtime_error("Invalid decode fraction must throw");
+        }
+
+        bool thrown = false;
+        try {
+            KNearestSurrogate model(10, 5);
+        }
+        catch(range_error&) {
+            thrown = true;
+        }
+        if(!thrown)
+            throw runtime_error("k larger than the capacity must throw");
+
+        // Disabling the surrogate.
+        algorithm.setSurrogateModel(nullptr, 1.0);
+        algorithm.evolve(5);
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}
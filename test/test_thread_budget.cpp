@@ -0,0 +1,156 @@
+/******************************************************************************
+ * test_thread_budget.cpp: test the thread budget of parallel decoders.
+ *
+ * (c) Copyright 2026, Carlos Eduardo de Andrade.
+ * All Rights Reserved.
+ *
+ *  Created on : Oct 18, 2026 by ceandrade
+ *  Last update: Oct 18, 2026 by ceandrade
+ *
+ * This code is released under LICENSE.md.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include "brkga_mp_ipr.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace BRKGA;
+
+//-------------------------------[ Decoder ]---------------------------------//
+
+// Computes the cost in parallel, splitting the keys in a fixed number of
+// chunks, so that the result does not depend on the number of threads.
+class Decoder {
+public:
+    static constexpr unsigned NUM_CHUNKS = 16;
+
+    double decode(Chromosome& chromosome, bool /*rewrite*/,
+                  DecodeContext& context) {
+        const unsigned num_threads = context.numThreads();
+        const auto in_use = threads_in_use += num_threads;
+        update_max(max_threads_in_use, in_use);
+        if(single_decode)
+            update_max(max_single_decode_threads, num_threads);
+
+        vector<double> partial(NUM_CHUNKS, 0.0);
+        const size_t chunk = (chromosome.size() + NUM_CHUNKS - 1) / NUM_CHUNKS;
+
+        #pragma omp parallel for num_threads(num_threads)
+        for(unsigned c = 0; c < NUM_CHUNKS; ++c) {
+            update_max(max_team_size, unsigned(omp_get_num_threads()));
+            const size_t end = min(chromosome.size(), (c + 1) * chunk);
+            for(size_t i = c * chunk; i < end; ++i)
+                partial[c] += fabs(chromosome[i] -
+                                   double((i * 7919u) % chromosome.size()) /
+                                   chromosome.size());
+        }
+
+        threads_in_use -= num_threads;
+
+        double cost = 0.0;
+        for(const auto value : partial)
+            cost += value;
+        return cost;
+    }
+
+    static void update_max(atomic<unsigned>& target, const unsigned value) {
+        unsigned current = target;
+        while(current < value &&
+              !target.compare_exchange_weak(current, value)) {}
+    }
+
+    atomic<unsigned> threads_in_use {0};
+    atomic<unsigned> max_threads_in_use {0};
+    atomic<unsigned> max_team_size {0};
+    atomic<unsigned> max_single_decode_threads {0};
+    bool single_decode {false};
+};
+
+//-------------------------------[ Main ]------------------------------------//
+
+int main(int argc, char* argv[]) {
+    const unsigned chr_size = (argc > 1)? atoi(argv[1]) : 1000;
+    const unsigned seed = (argc > 2)? atoi(argv[2]) : 2700001;
+    const unsigned num_threads = 4;
+    const unsigned budget = 8;
+
+    try {
+        auto [params, control_params] = readConfiguration("config_full.conf");
+        params.num_independent_populations = 1;
+        params.population_size = 50;
+
+        cout << "\n> Checking the thread budget..." << endl;
+
+        vector<fitness_t> best_fitness;
+        for(const unsigned decode_budget : {0u, budget}) {
+            Decoder decoder;
+            BRKGA_MP_IPR<Decoder> algorithm(decoder, Sense::MINIMIZE, seed,
+                                            chr_size, params, num_threads);
+            algorithm.setDecodeThreadBudget(decode_budget);
+            algorithm.evolve(20);
+
+            // A single decoding gets the whole budget.
+            decoder.single_decode = true;
+            Chromosome chromosome(chr_size, 0.5);
+            algorithm.injectChromosome(chromosome, 0,
+                                       params.population_size - 1);
+            decoder.single_decode = false;
+
+            cout << "- budget: " << decode_budget
+                 << " | max. threads in use: " << decoder.max_threads_in_use
+                 << " | max. team size: " << decoder.max_team_size
+                 << " | single decoding threads: "
+                 << decoder.max_single_decode_threads << endl;
+
+            const unsigned limit = max(decode_budget, num_threads);
+            if(decoder.max_threads_in_use > limit)
+                throw runtime_error("The thread budget was exceeded");
+
+            if(decode_budget > 0 &&
+               (decoder.max_team_size < 2 ||
+                decoder.max_single_decode_threads != decode_budget))
+                throw runtime_error("The thread budget was not used");
+
+            if(decode_budget == 0 && decoder.max_team_size != 1)
+                throw runtime_error("Decoders must run sequentially "
+                                    "without a budget");
+
+            best_fitness.push_back(algorithm.getBestFitness());
+        }
+
+        if(fabs(best_fitness[0] - best_fitness[1]) > 1e-9)
+            throw runtime_error("The budget changed the search trajectory");
+
+        cout << "All good!" << endl;
+    }
+    catch(exception& e) {
+        cerr << "\n***********************************************************"
+             << "\n****  Exception Occurred: " << e.what()
+             << "\n***********************************************************"
+             << endl;
+        return 70; // BSD software internal error code
+    }
+    return 0;
+}